@@ -8,6 +8,8 @@ Airport::Airport() {
     m_north = 0.0;
     m_west = 0.0;
     m_next = nullptr;
+    m_id = -1;
+    m_catalog = nullptr;
 }
 
 Airport::Airport(string code, string name, string city, string country, double north, double west) {
@@ -18,17 +20,33 @@ Airport::Airport(string code, string name, string city, string country, double n
     m_north = north;
     m_west = west;
     m_next = nullptr;
+    m_id = -1;
+    m_catalog = nullptr;
+}
+
+Airport::Airport(const AirportCatalog* catalog, int id) {
+    m_north = catalog->GetNorth(id);
+    m_west = catalog->GetWest(id);
+    m_next = nullptr;
+    m_id = id;
+    m_catalog = catalog;
 }
 
 Airport::~Airport() {
     // No dynamic memory to free
 }
 
-string Airport::GetCode() {
+string_view Airport::GetCode() {
+    if (m_catalog != nullptr) {
+        return m_catalog->GetCode(m_id);
+    }
     return m_code;
 }
 
-string Airport::GetName() {
+string_view Airport::GetName() {
+    if (m_catalog != nullptr) {
+        return m_catalog->GetName(m_id);
+    }
     return m_name;
 }
 
@@ -44,11 +62,17 @@ double Airport::GetWest() {
     return m_west;
 }
 
-string Airport::GetCity() {
+string_view Airport::GetCity() {
+    if (m_catalog != nullptr) {
+        return m_catalog->GetCity(m_id);
+    }
     return m_city;
 }
 
-string Airport::GetCountry() {
+string_view Airport::GetCountry() {
+    if (m_catalog != nullptr) {
+        return m_catalog->GetCountry(m_id);
+    }
     return m_country;
 }
 
@@ -56,3 +80,10 @@ void Airport::SetNext(Airport* next) {
     m_next = next;
 }
 
+int Airport::GetID() {
+    return m_id;
+}
+
+void Airport::SetID(int id) {
+    m_id = id;
+}
@@ -3,14 +3,19 @@
 //Date:    4/10/2024
 //Desc: This file contains the header details for the Airport class
 //      The airports are nodes for a route
+//      Airports in the Navigator's table keep no text of their own and
+//      read it from the AirportCatalog instead
 
 #ifndef AIRPORT_H
 #define AIRPORT_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+
+#include "AirportCatalog.h"
 using namespace std;
 
 class Airport {
@@ -27,6 +32,12 @@ class Airport {
   // Preconditions: None
   // Postconditions: Creates a new airport for use in a Route
   Airport(string, string, string, string, double, double);
+  // Name: Airport(AirportCatalog*, int) - Overloaded Constructor
+  // Desc: Used to build the airport stored in row id of a catalog
+  //   Text is not copied; getters return views into the catalog
+  // Preconditions: id is a valid row and the catalog outlives the airport
+  // Postconditions: Creates a new airport with m_id set to id
+  Airport(const AirportCatalog*, int);
   // Name: ~Airport() - Destructor
   // Desc: Used to destruct a airport
   //**This function should be empty but must be implemented
@@ -35,14 +46,15 @@ class Airport {
  ~Airport();
   // Name: GetCode()
   // Desc: Returns the three letter code of the airport
+  //   Text getters return views that live as long as the airport
   // Preconditions: None
   // Postconditions: Returns the three letter code of the airport
-  string GetCode();
+  string_view GetCode();
   // Name: GetName()
   // Desc: Returns the name of the airport
   // Preconditions: None
   // Postconditions: Returns the name of the airport
-  string GetName();
+  string_view GetName();
   // Name: GetNext()
   // Desc: Returns the pointer to the next airport
   // Preconditions: None (may return either airport or nullptr)
@@ -62,17 +74,29 @@ class Airport {
   // Desc: Returns the city of where the airport is located
   // Preconditions: None
   // Postconditions: Returns the city of where the airport is located
-  string GetCity();
+  string_view GetCity();
   // Name: GetCountry()
   // Desc: Returns the country of where the airport is located
   // Preconditions: None
   // Postconditions: Returns the country of where the airport is located
-  string GetCountry();
+  string_view GetCountry();
   // Name: SetNext()
   // Desc: Updates the pointer to a new target (either a airport or nullptr)
   // Preconditions: None
   // Postconditions: Sets the next airport
   void SetNext(Airport*);
+  // Name: GetID()
+  // Desc: Returns the position of the airport in the Navigator's
+  //   airport table (used to look up precomputed distances)
+  // Preconditions: None
+  // Postconditions: Returns m_id (-1 if the airport is not in a table)
+  int GetID();
+  // Name: SetID(int)
+  // Desc: Records the position of the airport in the Navigator's
+  //   airport table
+  // Preconditions: None
+  // Postconditions: Sets m_id
+  void SetID(int);
   // Name: operator<<
   // Desc: Overloaded << operator to return ostream from an Airport
   // Must not have a cout statement in this
@@ -80,7 +104,7 @@ class Airport {
   // Postconditions: Returns ostream populated with Airport's name and city
   // **PROVIDED** Do not edit
   friend ostream &operator<< (ostream &output, Airport &myAirport){
-    output << myAirport.m_name << ", " << myAirport.m_city;
+    output << myAirport.GetName() << ", " << myAirport.GetCity();
     return output;
   }
 private:
@@ -91,6 +115,8 @@ private:
   double m_north; //North of airport
   double m_west; //West of airport
   Airport *m_next; //Airport pointer to next airport
+  int m_id; //Index of airport in the airport table (-1 if none)
+  const AirportCatalog *m_catalog; //Catalog holding the text (nullptr if none)
 };
 
 #endif
@@ -0,0 +1,78 @@
+#include "AirportCatalog.h"
+
+AirportCatalog::AirportCatalog() {
+    m_codeSlots.assign(CODE_SLOTS, -1);
+}
+
+void AirportCatalog::Clear() {
+    m_strings.Clear();
+    m_codes.clear();
+    m_names.clear();
+    m_cities.clear();
+    m_countries.clear();
+    m_norths.clear();
+    m_wests.clear();
+    m_codeSlots.assign(CODE_SLOTS, -1);
+    m_otherCodes.clear();
+}
+
+void AirportCatalog::Reserve(int count) {
+    m_codes.reserve(count);
+    m_names.reserve(count);
+    m_cities.reserve(count);
+    m_countries.reserve(count);
+    m_norths.reserve(count);
+    m_wests.reserve(count);
+}
+
+int AirportCatalog::Add(string_view code, string_view name, string_view city,
+                        string_view country, double north, double west) {
+    int id = GetSize();
+    uint32_t codeID = m_strings.Intern(code);
+    int packed = PackCode(code);
+    if (packed >= 0) {
+        if (m_codeSlots[packed] == -1) {
+            m_codeSlots.Set(packed, id);
+        }
+    } else if (m_otherCodes.find(codeID) == m_otherCodes.end()) {
+        m_otherCodes[codeID] = id;
+    }
+    m_codes.push_back(codeID);
+    m_names.push_back(m_strings.Intern(name));
+    m_cities.push_back(m_strings.Intern(city));
+    m_countries.push_back(m_strings.Intern(country));
+    m_norths.push_back(north);
+    m_wests.push_back(west);
+    return id;
+}
+
+int AirportCatalog::FindOtherCode(string_view code) const {
+    int codeID = m_strings.Find(code);
+    if (codeID < 0) {
+        return -1;
+    }
+    unordered_map<uint32_t, int>::const_iterator found = m_otherCodes.find(codeID);
+    if (found == m_otherCodes.end()) {
+        return -1;
+    }
+    return found->second;
+}
+
+void AirportCatalog::RebuildOtherCodes() {
+    m_otherCodes.clear();
+    for (int id = 0; id < GetSize(); id++) {
+        if (PackCode(GetCode(id)) < 0 && m_otherCodes.find(m_codes[id]) == m_otherCodes.end()) {
+            m_otherCodes[m_codes[id]] = id;
+        }
+    }
+}
+
+const StringTable& AirportCatalog::GetStrings() const {
+    return m_strings;
+}
+
+size_t AirportCatalog::GetMemoryUsage() const {
+    return m_strings.GetMemoryUsage() + m_codeSlots.capacity() * sizeof(int) +
+        (m_codes.capacity() + m_names.capacity() + m_cities.capacity() + m_countries.capacity()) * sizeof(uint32_t) +
+        (m_norths.capacity() + m_wests.capacity()) * sizeof(double);
+}
@@ -0,0 +1,147 @@
+//Name: AirportCatalog.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the AirportCatalog class
+//      The catalog is the Navigator's airport table stored as columns
+//      (structure of arrays): one array of latitudes, one of longitudes
+//      and one of interned string ids per text field. Distance kernels
+//      read the coordinate columns directly and text is returned as
+//      string_views into a shared StringTable.
+//      Airports can be found by code in O(1): three-letter codes pack
+//      into 15 bits and index a direct-mapped array.
+
+#ifndef AIRPORTCATALOG_H
+#define AIRPORTCATALOG_H
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+#include "StringTable.h"
+#include "Column.h"
+using namespace std;
+
+//Constants
+const int CODE_SLOTS = 1 << 15; //Every packed three-letter code
+
+class AirportCatalog {
+ public:
+  // Name: AirportCatalog() - Default Constructor
+  // Desc: Builds an empty catalog
+  // Preconditions: None
+  // Postconditions: Catalog holds no airports
+  AirportCatalog();
+  // Name: Clear()
+  // Desc: Removes every airport and string
+  // Preconditions: None
+  // Postconditions: Catalog is empty
+  void Clear();
+  // Name: Reserve(int)
+  // Desc: Reserves room in every column for count airports
+  // Preconditions: None
+  // Postconditions: Columns will not reallocate before count airports
+  void Reserve(int count);
+  // Name: Add(string_view, string_view, string_view, string_view, double, double)
+  // Desc: Appends an airport given its code, name, city, country,
+  //   north, and west. Text is interned.
+  // Preconditions: None
+  //   If the code is already in the catalog, FindCode keeps
+  //   returning the first airport with that code.
+  // Postconditions: Returns the new airport's id (its row)
+  int Add(string_view code, string_view name, string_view city,
+          string_view country, double north, double west);
+  // Name: GetSize()
+  // Preconditions: None
+  // Postconditions: Returns the number of airports
+  int GetSize() const {
+    return static_cast<int>(m_norths.size());
+  }
+  // Name: GetCode / GetName / GetCity / GetCountry (int)
+  // Desc: Returns a field of an airport without copying it
+  //   (views stay valid until the next Add or Clear)
+  // Preconditions: id is in [0, GetSize())
+  // Postconditions: Returns the text
+  string_view GetCode(int id) const { return m_strings.Get(m_codes[id]); }
+  string_view GetName(int id) const { return m_strings.Get(m_names[id]); }
+  string_view GetCity(int id) const { return m_strings.Get(m_cities[id]); }
+  string_view GetCountry(int id) const { return m_strings.Get(m_countries[id]); }
+  // Name: GetNameID / GetCityID / GetCountryID (int)
+  // Desc: Returns the interned id of a field (equal ids mean equal text)
+  // Preconditions: id is in [0, GetSize())
+  // Postconditions: Returns the StringTable id
+  uint32_t GetNameID(int id) const { return m_names[id]; }
+  uint32_t GetCityID(int id) const { return m_cities[id]; }
+  uint32_t GetCountryID(int id) const { return m_countries[id]; }
+  // Name: GetNorth / GetWest (int)
+  // Preconditions: id is in [0, GetSize())
+  // Postconditions: Returns the coordinate in degrees
+  double GetNorth(int id) const { return m_norths[id]; }
+  double GetWest(int id) const { return m_wests[id]; }
+  // Name: GetNorths / GetWests
+  // Desc: Returns the whole coordinate column (GetSize() entries) for
+  //   the batch distance kernels
+  // Preconditions: None
+  // Postconditions: Returns a pointer to the column
+  const double* GetNorths() const { return m_norths.data(); }
+  const double* GetWests() const { return m_wests.data(); }
+  // Name: FindCode(string_view)
+  // Desc: Finds an airport by code without scanning the table
+  //   Three-letter codes are case-insensitive
+  // Preconditions: None
+  // Postconditions: Returns the airport's id, or -1 if there is none
+  int FindCode(string_view code) const {
+    int packed = PackCode(code);
+    if (packed >= 0) {
+      return m_codeSlots[packed];
+    }
+    return FindOtherCode(code);
+  }
+  // Name: PackCode(string_view)
+  // Desc: Packs a three-letter code into 15 bits (5 bits per letter)
+  // Preconditions: None
+  // Postconditions: Returns the packed code, or -1 if code is not
+  //   exactly three letters
+  static int PackCode(string_view code) {
+    if (code.size() != 3) {
+      return -1;
+    }
+    int packed = 0;
+    for (int i = 0; i < 3; i++) {
+      int letter = (code[i] | 0x20) - 'a'; //Lowercase the letter
+      if (letter < 0 || letter >= 26) {
+        return -1;
+      }
+      packed = (packed << 5) | letter;
+    }
+    return packed;
+  }
+  // Name: GetStrings()
+  // Preconditions: None
+  // Postconditions: Returns the interned string table
+  const StringTable& GetStrings() const;
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns bytes allocated by the columns and strings
+  size_t GetMemoryUsage() const;
+ private:
+  // Name: FindOtherCode(string_view)
+  // Desc: Lookup for codes that are not three letters
+  int FindOtherCode(string_view code) const;
+  StringTable m_strings; //Interned text of every field
+  Column<int> m_codeSlots; //Airport id by packed code (-1 if none)
+  unordered_map<uint32_t, int> m_otherCodes; //Airport id by code string id
+  // Name: RebuildOtherCodes()
+  // Desc: Rebuilds m_otherCodes from m_codes (after attaching columns)
+  void RebuildOtherCodes();
+  Column<uint32_t> m_codes; //Code string id of each airport
+  Column<uint32_t> m_names; //Name string id of each airport
+  Column<uint32_t> m_cities; //City string id of each airport
+  Column<uint32_t> m_countries; //Country string id of each airport
+  Column<double> m_norths; //Latitude of each airport (degrees)
+  Column<double> m_wests; //Longitude of each airport (degrees)
+  friend class Snapshot; //Saves and attaches the columns
+};
+
+#endif
@@ -0,0 +1,185 @@
+#include "AirportLoader.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// Removes spaces, tabs and a trailing carriage return
+string_view Trim(string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Parses all of text as a double
+bool ParseDouble(string_view text, double& value) {
+    text = Trim(text);
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1); // stod accepted a leading plus sign
+    }
+    if (text.empty()) {
+        return false;
+    }
+    const char* end = text.data() + text.size();
+    from_chars_result result = from_chars(text.data(), end, value);
+    return result.ec == errc() && result.ptr == end;
+}
+
+}
+
+AirportLoader::AirportLoader() {
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+    m_errorCount = 0;
+    m_errors = &cerr;
+}
+
+AirportLoader::~AirportLoader() {
+    Unmap();
+}
+
+bool AirportLoader::Map(const string& fileName) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+            m_mapping = mapping;
+            m_data = static_cast<const char*>(mapping);
+            m_size = info.st_size;
+            close(fd);
+            return true;
+        }
+    }
+    close(fd);
+
+    // Empty files, pipes and anything mmap refuses are read normally
+    ifstream inFile(fileName, ios::binary);
+    if (!inFile.is_open()) {
+        return false;
+    }
+    stringstream contents;
+    contents << inFile.rdbuf();
+    m_buffer = contents.str();
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+
+void AirportLoader::Unmap() {
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_size);
+    }
+    m_mapping = nullptr;
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool AirportLoader::Load(const string& fileName, AirportCatalog& catalog) {
+    Unmap();
+    m_fileName = fileName;
+    m_errorCount = 0;
+    if (!Map(fileName)) {
+        return false;
+    }
+
+    // Count the lines first so every catalog column is allocated once
+    const char* end = m_data + m_size;
+    int lines = 0;
+    for (const char* p = m_data; p < end; p++) {
+        p = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (p == nullptr) {
+            break;
+        }
+        lines++;
+    }
+    catalog.Reserve(catalog.GetSize() + lines + 1);
+
+    int lineNumber = 0;
+    const char* start = m_data;
+    while (start < end) {
+        const char* newline = static_cast<const char*>(memchr(start, '\n', end - start));
+        const char* stop = newline == nullptr ? end : newline;
+        lineNumber++;
+        ParseLine(string_view(start, stop - start), lineNumber, catalog);
+        start = stop + 1;
+    }
+
+    Unmap();
+    return true;
+}
+
+bool AirportLoader::ParseLine(string_view line, int lineNumber, AirportCatalog& catalog) {
+    if (Trim(line).empty()) {
+        return true; // Blank lines are not errors
+    }
+
+    // Split in place; one extra slot detects rows with too many fields
+    string_view fields[AIRPORT_FIELDS + 1];
+    int count = 0;
+    size_t start = 0;
+    while (count <= AIRPORT_FIELDS) {
+        size_t comma = line.find(',', start);
+        if (comma == string_view::npos) {
+            fields[count++] = line.substr(start);
+            break;
+        }
+        fields[count++] = line.substr(start, comma - start);
+        start = comma + 1;
+    }
+    if (count != AIRPORT_FIELDS) {
+        Report(lineNumber, count > AIRPORT_FIELDS ? "too many fields (expected 6)"
+               : "expected 6 fields, found " + to_string(count));
+        return false;
+    }
+
+    double north;
+    double west;
+    if (!ParseDouble(fields[4], north) || north < -90.0 || north > 90.0) {
+        Report(lineNumber, "invalid north coordinate '" + string(Trim(fields[4])) + "'");
+        return false;
+    }
+    if (!ParseDouble(fields[5], west) || west < -180.0 || west > 180.0) {
+        Report(lineNumber, "invalid west coordinate '" + string(Trim(fields[5])) + "'");
+        return false;
+    }
+    if (fields[0].empty()) {
+        Report(lineNumber, "missing airport code");
+        return false;
+    }
+
+    catalog.Add(fields[0], fields[1], fields[2], fields[3], north, west);
+    return true;
+}
+
+void AirportLoader::Report(int lineNumber, const string& reason) {
+    m_errorCount++;
+    if (m_errors != nullptr) {
+        *m_errors << m_fileName << ":" << lineNumber << ": " << reason << endl;
+    }
+}
+
+int AirportLoader::GetErrorCount() const {
+    return m_errorCount;
+}
+
+void AirportLoader::SetErrorStream(ostream* errors) {
+    m_errors = errors;
+}
@@ -0,0 +1,74 @@
+//Name: AirportLoader.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the AirportLoader class
+//      The loader memory-maps an airport file (code,name,city,country,
+//      north,west per line) and parses it in place: fields are string_views
+//      into the mapping and coordinates are read with from_chars, so no
+//      per-line strings are built. Malformed rows are reported with their
+//      line number instead of being dropped silently.
+
+#ifndef AIRPORTLOADER_H
+#define AIRPORTLOADER_H
+
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <cstddef>
+
+#include "AirportCatalog.h"
+using namespace std;
+
+//Constants
+const int AIRPORT_FIELDS = 6; //Fields in each line of an airport file
+
+class AirportLoader {
+ public:
+  // Name: AirportLoader() - Default Constructor
+  // Desc: Builds a loader that reports malformed rows to cerr
+  // Preconditions: None
+  // Postconditions: No file is mapped
+  AirportLoader();
+  // Name: ~AirportLoader() - Destructor
+  // Desc: Unmaps the file if one is still mapped
+  // Preconditions: None
+  // Postconditions: All mappings are released
+  ~AirportLoader();
+  // Name: Load(string, AirportCatalog&)
+  // Desc: Appends every well-formed row of the file to the catalog
+  //   Blank lines are ignored. Rows with the wrong number of fields or
+  //   bad coordinates are reported as "file:line: reason" and skipped.
+  // Preconditions: None
+  // Postconditions: Returns false if the file could not be opened
+  bool Load(const string& fileName, AirportCatalog& catalog);
+  // Name: GetErrorCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of rows skipped by the last Load
+  int GetErrorCount() const;
+  // Name: SetErrorStream(ostream*)
+  // Desc: Changes where malformed rows are reported (nullptr for nowhere)
+  // Preconditions: None
+  // Postconditions: Sets m_errors
+  void SetErrorStream(ostream* errors);
+ private:
+  // Name: Map(string) / Unmap()
+  // Desc: Maps the whole file read-only (falls back to reading it into
+  //   m_buffer when mmap is not possible)
+  bool Map(const string& fileName);
+  void Unmap();
+  // Name: ParseLine(string_view, int, AirportCatalog&)
+  // Desc: Parses one line; returns false and reports it if malformed
+  bool ParseLine(string_view line, int lineNumber, AirportCatalog& catalog);
+  // Name: Report(int, string)
+  // Desc: Writes "file:line: reason" to m_errors
+  void Report(int lineNumber, const string& reason);
+  const char *m_data; //Start of the file's bytes
+  size_t m_size; //Number of bytes
+  void *m_mapping; //mmap result (nullptr if m_buffer is used)
+  string m_buffer; //File contents when it could not be mapped
+  string m_fileName; //File being loaded
+  int m_errorCount; //Rows skipped by the last Load
+  ostream *m_errors; //Where malformed rows are reported
+};
+
+#endif
@@ -0,0 +1,973 @@
+#include "BatchDriver.h"
+
+#include <charconv>
+#include <cmath>
+
+BatchDriver::BatchDriver(Navigator& navigator, ostream& out, BatchFormat format)
+    : m_navigator(navigator), m_out(out), m_format(format), m_capturing(false),
+      m_readOnly(false) {
+    m_buffer.reserve(BATCH_BUFFER + 1024);
+    if (m_format == BATCH_CSV) {
+        m_buffer += "line,command,ok,route,name,miles,routes,legs,min_leg,max_leg,airports,distances,matches,shared,error,stats,degrees,betweenness,network,top,count,ingest,reachable,hops,shape,polyline,memory\n";
+    }
+}
+
+BatchDriver::~BatchDriver() {
+    Flush();
+}
+
+void BatchDriver::SetReadOnly(bool readOnly) {
+    m_readOnly = readOnly;
+}
+
+void BatchDriver::Flush() {
+    m_out.write(m_buffer.data(), m_buffer.size());
+    m_out.flush();
+    m_buffer.clear();
+}
+
+int BatchDriver::Run(istream& in) {
+    int failures = 0;
+    int lineNumber = 0;
+    string line;
+    while (getline(in, line)) {
+        lineNumber++;
+        if (!RunCommand(line, lineNumber)) {
+            failures++;
+        }
+    }
+    Flush();
+    return failures;
+}
+
+bool BatchDriver::RunCommand(string_view line, int lineNumber) {
+    // Split on spaces and tabs (views into line, nothing copied)
+    m_words.clear();
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) {
+            i++;
+        }
+        size_t start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r') {
+            i++;
+        }
+        if (i > start) {
+            m_words.push_back(line.substr(start, i - start));
+        }
+    }
+    if (m_words.empty() || m_words[0][0] == '#') {
+        return true; // Blank lines and comments have no result.
+    }
+    STATS_TIMER(STAT_COMMAND);
+
+    Result& result = m_result;
+    result.line = lineNumber;
+    result.command = m_words[0];
+    result.ok = true;
+    result.route = 0;
+    result.miles = -1;
+    result.routes = 0;
+    result.legs = -1;
+    result.minLeg = 0;
+    result.maxLeg = 0;
+    result.airports.clear();
+    result.distances.clear();
+    result.matches.clear();
+    result.shared.clear();
+    result.degrees.clear();
+    result.betweenness.clear();
+    result.name.clear();
+    result.stats.clear();
+    result.memory.clear();
+    result.network.clear();
+    result.top.clear();
+    result.count = -1;
+    result.ingest.clear();
+    result.reachable = -1;
+    result.hops = -1;
+    result.shape = -1;
+    result.polyline = false;
+    result.error.clear();
+    Execute(result);
+    Write(result);
+    if (!m_capturing && m_buffer.size() >= BATCH_BUFFER) {
+        m_out.write(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+    return result.ok;
+}
+
+bool BatchDriver::RunCommand(string_view line, int lineNumber, string& out) {
+    // Results go straight onto out; swapping buffers copies nothing
+    m_buffer.swap(out);
+    m_capturing = true;
+    bool ok = RunCommand(line, lineNumber);
+    m_capturing = false;
+    m_buffer.swap(out);
+    return ok;
+}
+
+void BatchDriver::Execute(Result& result) {
+    string_view command = m_words[0];
+    int words = static_cast<int>(m_words.size());
+    int index = -1;
+
+    if (m_readOnly && (command == "create" || command == "remove" || command == "reverse" ||
+                       command == "optimize" || command == "ingest" ||
+                       (command == "stats" && words > 1))) {
+        result.ok = false;
+        result.error = "command not allowed (read-only)";
+        return;
+    }
+
+    if (command == "create") {
+        if (!ParseStops(result)) {
+            return;
+        }
+        index = m_navigator.AddRoute(m_ids);
+        if (index < 0) {
+            result.ok = false;
+            result.error = "route needs at least " + to_string(ROUTE_MIN) + " airports";
+            return;
+        }
+        DescribeRoute(m_navigator.GetRoute(index), index, result);
+    } else if (command == "score") {
+        // Measures the stops as a route without storing one
+        if (!ParseStops(result)) {
+            return;
+        }
+        int size = static_cast<int>(m_ids.size());
+        if (size < ROUTE_MIN) {
+            result.ok = false;
+            result.error = "route needs at least " + to_string(ROUTE_MIN) + " airports";
+            return;
+        }
+        RouteStats stats = {0.0, 0, 0.0, 0.0};
+        for (int i = 0; i + 1 < size; i++) {
+            double leg = m_navigator.AirportDistance(m_ids[i], m_ids[i + 1]);
+            if (stats.legs == 0 || leg < stats.minLeg) {
+                stats.minLeg = leg;
+            }
+            if (leg > stats.maxLeg) {
+                stats.maxLeg = leg;
+            }
+            stats.miles += leg;
+            stats.legs++;
+        }
+        SetStats(stats, result);
+        result.airports = m_ids;
+    } else if (command == "distance" && words == 3) {
+        int from = ParseAirport(m_words[1]);
+        int to = ParseAirport(m_words[2]);
+        if (from < 0 || to < 0) {
+            result.ok = false;
+            result.error = "usage: distance ROUTE or distance FROM TO";
+            return;
+        }
+        result.airports.push_back(from);
+        result.airports.push_back(to);
+        result.miles = m_navigator.AirportDistance(from, to);
+    } else if (command == "distance" || command == "display" || command == "reverse") {
+        Route* route = words == 2 ? ParseRoute(m_words[1], index) : nullptr;
+        if (route == nullptr) {
+            result.ok = false;
+            result.error = command == "distance" ? "usage: distance ROUTE or distance FROM TO"
+                                                 : "usage: " + string(command) + " ROUTE";
+            return;
+        }
+        if (command == "reverse") {
+            m_navigator.ReverseStops(index);
+        }
+        if (command == "distance") {
+            // Only the numbers are wanted; skip building the name and stops
+            result.route = index + 1;
+            SetStats(m_navigator.MeasureRoute(route), result);
+        } else {
+            DescribeRoute(route, index, result);
+        }
+    } else if (command == "shape") {
+        Route* route = words == 4 || words == 5 ? ParseRoute(m_words[1], index) : nullptr;
+        ShapeSpacing spacing = {0.0, 0};
+        bool valid = route != nullptr && (words == 4 || m_words[4] == "polyline");
+        if (valid) {
+            const char* end = m_words[3].data() + m_words[3].size();
+            if (m_words[2] == "miles") {
+                valid = from_chars(m_words[3].data(), end, spacing.maxSegment).ptr == end &&
+                    spacing.maxSegment > 0;
+            } else if (m_words[2] == "points") {
+                valid = from_chars(m_words[3].data(), end, spacing.points).ptr == end &&
+                    spacing.points >= 2;
+            } else {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            result.ok = false;
+            result.error = "usage: shape ROUTE miles MILES|points N [polyline]";
+            return;
+        }
+        // Checked up front, as the text goes straight into the answer
+        long points = m_navigator.CountRoutePoints(index, spacing);
+        if (points > BATCH_SHAPE_POINTS) {
+            result.ok = false;
+            result.error = "shape has " + to_string(points) + " points (at most " +
+                to_string(BATCH_SHAPE_POINTS) + ")";
+            return;
+        }
+        result.route = index + 1;
+        result.name = route->GetName();
+        result.shape = index;
+        result.spacing = spacing;
+        result.polyline = words == 5;
+    } else if (command == "remove") {
+        Route* route = words == 3 ? ParseRoute(m_words[1], index) : nullptr;
+        if (route == nullptr) {
+            result.ok = false;
+            result.error = "usage: remove ROUTE AIRPORT";
+            return;
+        }
+        // A number is a position in the route, otherwise a code
+        int position = -1;
+        const char* end = m_words[2].data() + m_words[2].size();
+        if (from_chars(m_words[2].data(), end, position).ptr == end) {
+            position--;
+        } else {
+            int id = m_navigator.FindAirport(m_words[2]);
+            for (int i = 0; i < route->GetSize() && position < 0; i++) {
+                if (id >= 0 && route->GetID(i) == id) {
+                    position = i;
+                }
+            }
+        }
+        if (position < 0 || position >= route->GetSize()) {
+            result.ok = false;
+            result.error = "airport " + string(m_words[2]) + " is not in route " + string(m_words[1]);
+        } else if (route->GetSize() <= ROUTE_MIN) {
+            result.ok = false;
+            result.error = "route cannot have less than " + to_string(ROUTE_MIN) + " airports";
+        } else {
+            m_navigator.RemoveStop(index, position);
+            route->SetName(route->UpdateName());
+            DescribeRoute(route, index, result);
+        }
+    } else if (command == "plan") {
+        double range = -1;
+        int start = words == 4 ? ParseAirport(m_words[1]) : -1;
+        int goal = words == 4 ? ParseAirport(m_words[2]) : -1;
+        if (words == 4) {
+            const char* end = m_words[3].data() + m_words[3].size();
+            if (from_chars(m_words[3].data(), end, range).ptr != end) {
+                range = -1;
+            }
+        }
+        if (start < 0 || goal < 0 || range < 0) {
+            result.ok = false;
+            result.error = "usage: plan FROM TO RANGE";
+            return;
+        }
+        if (start == goal) {
+            result.ok = false;
+            result.error = "FROM and TO must be different airports";
+            return;
+        }
+        Route* route = m_navigator.PlanRoute(start, goal, range);
+        if (route == nullptr) {
+            result.ok = false;
+            result.error = "no route within range";
+            return;
+        }
+        if (m_readOnly) {
+            // Only the path is returned; nothing is stored
+            DescribeRoute(route, -1, result);
+            delete route;
+            return;
+        }
+        index = m_navigator.AddRoute(route);
+        DescribeRoute(route, index, result);
+    } else if (command == "pareto") {
+        double range = -1;
+        int hops = PARETO_MAX_HOPS;
+        int start = words == 4 || words == 5 ? ParseAirport(m_words[1]) : -1;
+        int goal = words == 4 || words == 5 ? ParseAirport(m_words[2]) : -1;
+        if (words == 4 || words == 5) {
+            const char* end = m_words[3].data() + m_words[3].size();
+            if (from_chars(m_words[3].data(), end, range).ptr != end) {
+                range = -1;
+            }
+        }
+        if (words == 5) {
+            const char* end = m_words[4].data() + m_words[4].size();
+            if (from_chars(m_words[4].data(), end, hops).ptr != end) {
+                hops = 0;
+            }
+        }
+        if (start < 0 || goal < 0 || range < 0 || hops < 1) {
+            result.ok = false;
+            result.error = "usage: pareto FROM TO RANGE [HOPS]";
+            return;
+        }
+        if (start == goal) {
+            result.ok = false;
+            result.error = "FROM and TO must be different airports";
+            return;
+        }
+        vector<Route*> routes;
+        if (m_navigator.ParetoRoutes(start, goal, range, hops, routes) == 0) {
+            result.ok = false;
+            result.error = "no route within range";
+            return;
+        }
+        // One result per route; the last is written by RunCommand
+        for (int i = 0; i < static_cast<int>(routes.size()); i++) {
+            if (i > 0) {
+                Write(result);
+                result.airports.clear();
+            }
+            DescribeRoute(routes[i], -1, result);
+            SetStats(m_navigator.MeasureRoute(routes[i]), result);
+            delete routes[i];
+        }
+    } else if (command == "reach") {
+        double range = -1;
+        int hops = 0;
+        int start = words == 4 || words == 5 ? ParseAirport(m_words[1]) : -1;
+        int goal = words == 4 || words == 5 ? ParseAirport(m_words[2]) : -1;
+        if (words == 4 || words == 5) {
+            const char* end = m_words[3].data() + m_words[3].size();
+            if (from_chars(m_words[3].data(), end, range).ptr != end) {
+                range = -1;
+            }
+        }
+        if (words == 5) {
+            const char* end = m_words[4].data() + m_words[4].size();
+            if (from_chars(m_words[4].data(), end, hops).ptr != end || hops < 1) {
+                hops = -1;
+            }
+        }
+        if (start < 0 || goal < 0 || range < 0 || hops < 0) {
+            result.ok = false;
+            result.error = "usage: reach FROM TO RANGE [HOPS]";
+            return;
+        }
+        result.airports.push_back(start);
+        result.airports.push_back(goal);
+        result.reachable = m_navigator.Reachable(start, goal, range, hops, result.hops) ? 1 : 0;
+    } else if (command == "optimize") {
+        Route* route = words >= 2 && words <= 4 ? ParseRoute(m_words[1], index) : nullptr;
+        bool fixEnd = false;
+        double budget = OPT_BUDGET_MS;
+        bool valid = route != nullptr;
+        for (int i = 2; i < words && valid; i++) {
+            const char* end = m_words[i].data() + m_words[i].size();
+            if (m_words[i] == "fixed") {
+                fixEnd = true;
+            } else if (from_chars(m_words[i].data(), end, budget).ptr != end || budget < 0) {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            result.ok = false;
+            result.error = "usage: optimize ROUTE [fixed] [MS]";
+            return;
+        }
+        OptimizeStats stats;
+        if (!m_navigator.OptimizeRoute(index, fixEnd, budget, stats)) {
+            result.ok = false;
+            result.error = "no route " + string(m_words[1]);
+            return;
+        }
+        DescribeRoute(m_navigator.GetRoute(index), index, result);
+    } else if (command == "measure") {
+        vector<RouteStats> stats;
+        SetStats(m_navigator.MeasureRoutes(stats), result);
+        result.routes = static_cast<int>(stats.size());
+    } else if (command == "through") {
+        m_ids.clear();
+        for (int i = 1; i < words; i++) {
+            int id = ParseAirport(m_words[i]);
+            if (id < 0) {
+                result.ok = false;
+                result.error = "unknown airport " + string(m_words[i]);
+                return;
+            }
+            m_ids.push_back(id);
+        }
+        if (m_ids.empty()) {
+            result.ok = false;
+            result.error = "usage: through AIRPORT [AIRPORT ...]";
+            return;
+        }
+        m_navigator.RoutesThrough(m_ids, result.matches);
+        for (int i = 0; i < static_cast<int>(result.matches.size()); i++) {
+            result.matches[i]++;
+        }
+    } else if (command == "similar") {
+        Route* route = words == 3 ? ParseRoute(m_words[1], index) : nullptr;
+        int k = 0;
+        if (words == 3) {
+            const char* end = m_words[2].data() + m_words[2].size();
+            if (from_chars(m_words[2].data(), end, k).ptr != end) {
+                k = 0;
+            }
+        }
+        if (route == nullptr || k < 1) {
+            result.ok = false;
+            result.error = "usage: similar ROUTE K";
+            return;
+        }
+        if (!m_navigator.SimilarRoutes(index, k, result.matches, result.shared)) {
+            result.ok = false;
+            result.error = "no route " + string(m_words[1]);
+            return;
+        }
+        result.route = index + 1;
+        for (int i = 0; i < static_cast<int>(result.matches.size()); i++) {
+            result.matches[i]++;
+        }
+    } else if (command == "nearest") {
+        int id = words == 3 ? ParseAirport(m_words[1]) : -1;
+        int k = -1;
+        if (words == 3) {
+            const char* end = m_words[2].data() + m_words[2].size();
+            if (from_chars(m_words[2].data(), end, k).ptr != end) {
+                k = -1;
+            }
+        }
+        if (id < 0 || k < 0) {
+            result.ok = false;
+            result.error = "usage: nearest AIRPORT K";
+            return;
+        }
+        m_navigator.NearestAirports(id, k, result.airports, result.distances);
+    } else if (command == "hubs") {
+        int k = -1;
+        if (words == 2) {
+            const char* end = m_words[1].data() + m_words[1].size();
+            if (from_chars(m_words[1].data(), end, k).ptr != end) {
+                k = -1;
+            }
+        }
+        if (k < 0) {
+            result.ok = false;
+            result.error = "usage: hubs K";
+            return;
+        }
+        m_navigator.HubAirports(k, result.airports, result.betweenness, result.degrees);
+    } else if (command == "network") {
+        if (words != 1) {
+            result.ok = false;
+            result.error = "usage: network";
+            return;
+        }
+        NetworkStats network = m_navigator.GetNetworkStats();
+        result.network = "{\"airports\":" + to_string(network.airports) +
+            ",\"edges\":" + to_string(network.edges) +
+            ",\"components\":" + to_string(network.components) +
+            ",\"largest\":" + to_string(network.largest) +
+            ",\"strong_components\":" + to_string(network.strongComponents) + "}";
+    } else if (command == "ingest") {
+        bool wait = words == 3 && m_words[2] == "wait";
+        if (words < 2 || (words == 3 && !wait) || words > 3) {
+            result.ok = false;
+            result.error = "usage: ingest FILE [wait]";
+            return;
+        }
+        if (!m_navigator.IngestLegs(string(m_words[1]), wait)) {
+            result.ok = false;
+            result.error = "cannot open " + string(m_words[1]);
+            return;
+        }
+        if (wait) {
+            DescribeLegs(*m_navigator.GetLegSnapshot(), result);
+        }
+    } else if (command == "legs") {
+        int k = words == 1 ? LEG_TOP_K : -1;
+        if (words == 2) {
+            const char* end = m_words[1].data() + m_words[1].size();
+            if (from_chars(m_words[1].data(), end, k).ptr != end) {
+                k = -1;
+            }
+        }
+        if (k < 0 || words > 2) {
+            result.ok = false;
+            result.error = "usage: legs [K]";
+            return;
+        }
+        // Hold the snapshot so ingestion can publish a newer one meanwhile
+        shared_ptr<const LegSnapshot> snapshot = m_navigator.GetLegSnapshot();
+        DescribeLegs(*snapshot, result);
+        int keep = k < static_cast<int>(snapshot->top.size()) ? k : static_cast<int>(snapshot->top.size());
+        result.top.assign(snapshot->top.begin(), snapshot->top.begin() + keep);
+    } else if (command == "leg") {
+        int from = words == 3 ? ParseAirport(m_words[1]) : -1;
+        int to = words == 3 ? ParseAirport(m_words[2]) : -1;
+        if (from < 0 || to < 0) {
+            result.ok = false;
+            result.error = "usage: leg FROM TO";
+            return;
+        }
+        result.airports.push_back(from);
+        result.airports.push_back(to);
+        result.count = m_navigator.EstimateLegCount(from, to);
+    } else if (command == "stats") {
+        if (words > 2 || (words == 2 && m_words[1] != "reset")) {
+            result.ok = false;
+            result.error = "usage: stats [reset]";
+            return;
+        }
+        if (words == 2 && !Stats::IsEnabled()) {
+            result.ok = false;
+            result.error = "stats are not compiled in (build with make STATS=1)";
+            return;
+        }
+        // Memory is reported whether or not stats are compiled in
+        MemoryUsage memory = m_navigator.GetMemoryUsage();
+        result.memory = "{\"catalog\":" + to_string(memory.catalog) +
+            ",\"distances\":" + to_string(memory.distances) +
+            ",\"route_index\":" + to_string(memory.routeIndex) +
+            ",\"reachability\":" + to_string(memory.reachability) +
+            ",\"legs\":" + to_string(memory.legs) +
+            ",\"total\":" + to_string(memory.total) + "}";
+        if (Stats::IsEnabled()) {
+            Stats::AppendJSON(result.stats);
+        }
+        if (words == 2) {
+            Stats::Reset();
+        }
+    } else {
+        result.ok = false;
+        result.error = "unknown command";
+    }
+}
+
+int BatchDriver::ParseAirport(string_view word) {
+    int number = 0;
+    const char* end = word.data() + word.size();
+    if (from_chars(word.data(), end, number).ptr == end) {
+        return number >= 1 && number <= m_navigator.GetAirportCount() ? number - 1 : -1;
+    }
+    return m_navigator.FindAirport(word);
+}
+
+Route* BatchDriver::ParseRoute(string_view word, int& index) {
+    int number = 0;
+    const char* end = word.data() + word.size();
+    if (from_chars(word.data(), end, number).ptr != end) {
+        return nullptr;
+    }
+    index = number - 1;
+    return m_navigator.GetRoute(index);
+}
+
+bool BatchDriver::ParseStops(Result& result) {
+    m_ids.clear();
+    for (int i = 1; i < static_cast<int>(m_words.size()); i++) {
+        int id = ParseAirport(m_words[i]);
+        if (id < 0) {
+            result.ok = false;
+            result.error = "unknown airport " + string(m_words[i]);
+            return false;
+        }
+        m_ids.push_back(id);
+    }
+    return true;
+}
+
+void BatchDriver::SetStats(const RouteStats& stats, Result& result) {
+    result.miles = stats.miles;
+    result.legs = stats.legs;
+    result.minLeg = stats.minLeg;
+    result.maxLeg = stats.maxLeg;
+}
+
+void BatchDriver::DescribeRoute(Route* route, int index, Result& result) {
+    result.route = index + 1;
+    result.name = route->UpdateName();
+    for (int i = 0; i < route->GetSize(); i++) {
+        result.airports.push_back(route->GetID(i));
+    }
+    result.miles = m_navigator.RouteDistance(route);
+}
+
+void BatchDriver::DescribeLegs(const LegSnapshot& snapshot, Result& result) {
+    char miles[32];
+    char* end = to_chars(miles, miles + sizeof(miles), snapshot.miles, chars_format::fixed, 2).ptr;
+    result.ingest = "{\"lines\":" + to_string(snapshot.lines) +
+        ",\"legs\":" + to_string(snapshot.legs) +
+        ",\"skipped\":" + to_string(snapshot.skipped) +
+        ",\"miles\":" + string(miles, end - miles) +
+        (snapshot.done ? ",\"done\":true}" : ",\"done\":false}");
+}
+
+void BatchDriver::Write(const Result& result) {
+    if (m_format == BATCH_CSV) {
+        WriteCSV(result);
+    } else {
+        WriteJSON(result);
+    }
+}
+
+void BatchDriver::WriteJSON(const Result& result) {
+    m_buffer += "{\"line\":";
+    AppendNumber(result.line);
+    m_buffer += ",\"command\":";
+    AppendQuoted(result.command, '"');
+    m_buffer += result.ok ? ",\"ok\":true" : ",\"ok\":false";
+    if (result.route > 0) {
+        m_buffer += ",\"route\":";
+        AppendNumber(result.route);
+    }
+    if (!result.name.empty()) {
+        m_buffer += ",\"name\":";
+        AppendQuoted(result.name, '"');
+    }
+    if (result.miles >= 0) {
+        m_buffer += ",\"miles\":";
+        AppendMiles(result.miles);
+    }
+    if (result.routes > 0) {
+        m_buffer += ",\"routes\":";
+        AppendNumber(result.routes);
+    }
+    if (result.legs >= 0) {
+        m_buffer += ",\"legs\":";
+        AppendNumber(result.legs);
+        m_buffer += ",\"min_leg\":";
+        AppendMiles(result.minLeg);
+        m_buffer += ",\"max_leg\":";
+        AppendMiles(result.maxLeg);
+    }
+    if (!result.airports.empty()) {
+        m_buffer += ",\"airports\":[";
+        for (int i = 0; i < static_cast<int>(result.airports.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendQuoted(m_navigator.GetAirport(result.airports[i])->GetCode(), '"');
+        }
+        m_buffer += ']';
+    }
+    if (!result.distances.empty()) {
+        m_buffer += ",\"distances\":[";
+        for (int i = 0; i < static_cast<int>(result.distances.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendMiles(result.distances[i]);
+        }
+        m_buffer += ']';
+    }
+    if (result.ok && (!result.matches.empty() || result.command == "through" || result.command == "similar")) {
+        m_buffer += ",\"matches\":[";
+        for (int i = 0; i < static_cast<int>(result.matches.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendNumber(result.matches[i]);
+        }
+        m_buffer += ']';
+    }
+    if (!result.shared.empty()) {
+        m_buffer += ",\"shared\":[";
+        for (int i = 0; i < static_cast<int>(result.shared.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendNumber(result.shared[i]);
+        }
+        m_buffer += ']';
+    }
+    if (!result.degrees.empty()) {
+        m_buffer += ",\"degrees\":[";
+        for (int i = 0; i < static_cast<int>(result.degrees.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendNumber(result.degrees[i]);
+        }
+        m_buffer += ']';
+    }
+    if (!result.betweenness.empty()) {
+        m_buffer += ",\"betweenness\":[";
+        for (int i = 0; i < static_cast<int>(result.betweenness.size()); i++) {
+            if (i > 0) {
+                m_buffer += ',';
+            }
+            AppendMiles(result.betweenness[i]);
+        }
+        m_buffer += ']';
+    }
+    if (!result.stats.empty()) {
+        m_buffer += ",\"stats\":";
+        m_buffer += result.stats;
+    }
+    if (!result.memory.empty()) {
+        m_buffer += ",\"memory\":";
+        m_buffer += result.memory;
+    }
+    if (!result.network.empty()) {
+        m_buffer += ",\"network\":";
+        m_buffer += result.network;
+    }
+    if (!result.top.empty()) {
+        m_buffer += ",\"top\":[";
+        for (int i = 0; i < static_cast<int>(result.top.size()); i++) {
+            const LegCount& leg = result.top[i];
+            m_buffer += i > 0 ? ",{\"from\":" : "{\"from\":";
+            AppendQuoted(m_navigator.GetAirport(leg.from)->GetCode(), '"');
+            m_buffer += ",\"to\":";
+            AppendQuoted(m_navigator.GetAirport(leg.to)->GetCode(), '"');
+            m_buffer += ",\"count\":";
+            AppendNumber(leg.count);
+            m_buffer += ",\"error\":";
+            AppendNumber(leg.error);
+            m_buffer += '}';
+        }
+        m_buffer += ']';
+    }
+    if (result.count >= 0) {
+        m_buffer += ",\"count\":";
+        AppendNumber(result.count);
+    }
+    if (!result.ingest.empty()) {
+        m_buffer += ",\"ingest\":";
+        m_buffer += result.ingest;
+    }
+    if (result.reachable >= 0) {
+        m_buffer += result.reachable ? ",\"reachable\":true,\"hops\":" : ",\"reachable\":false,\"hops\":";
+        AppendNumber(result.hops);
+    }
+    if (result.shape >= 0) {
+        m_buffer += result.polyline ? ",\"polyline\":" : ",\"shape\":";
+        AppendShape(result, '"');
+    }
+    if (!result.ok) {
+        m_buffer += ",\"error\":";
+        AppendQuoted(result.error, '"');
+    }
+    m_buffer += "}\n";
+}
+
+void BatchDriver::WriteCSV(const Result& result) {
+    AppendNumber(result.line);
+    m_buffer += ',';
+    AppendQuoted(result.command, ',');
+    m_buffer += result.ok ? ",true," : ",false,";
+    if (result.route > 0) {
+        AppendNumber(result.route);
+    }
+    m_buffer += ',';
+    AppendQuoted(result.name, ',');
+    m_buffer += ',';
+    if (result.miles >= 0) {
+        AppendMiles(result.miles);
+    }
+    m_buffer += ',';
+    if (result.routes > 0) {
+        AppendNumber(result.routes);
+    }
+    m_buffer += ',';
+    if (result.legs >= 0) {
+        AppendNumber(result.legs);
+        m_buffer += ',';
+        AppendMiles(result.minLeg);
+        m_buffer += ',';
+        AppendMiles(result.maxLeg);
+    } else {
+        m_buffer += ",,";
+    }
+    // Lists are space-separated within one field
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.airports.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendQuoted(m_navigator.GetAirport(result.airports[i])->GetCode(), ',');
+    }
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.distances.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendMiles(result.distances[i]);
+    }
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.matches.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendNumber(result.matches[i]);
+    }
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.shared.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendNumber(result.shared[i]);
+    }
+    m_buffer += ',';
+    AppendQuoted(result.error, ',');
+    m_buffer += ',';
+    AppendQuoted(result.stats, ',');
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.degrees.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendNumber(result.degrees[i]);
+    }
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.betweenness.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendMiles(result.betweenness[i]);
+    }
+    m_buffer += ',';
+    AppendQuoted(result.network, ',');
+    // Legs as FROM-TO:COUNT
+    m_buffer += ',';
+    for (int i = 0; i < static_cast<int>(result.top.size()); i++) {
+        if (i > 0) {
+            m_buffer += ' ';
+        }
+        AppendQuoted(m_navigator.GetAirport(result.top[i].from)->GetCode(), ',');
+        m_buffer += '-';
+        AppendQuoted(m_navigator.GetAirport(result.top[i].to)->GetCode(), ',');
+        m_buffer += ':';
+        AppendNumber(result.top[i].count);
+    }
+    m_buffer += ',';
+    if (result.count >= 0) {
+        AppendNumber(result.count);
+    }
+    m_buffer += ',';
+    AppendQuoted(result.ingest, ',');
+    m_buffer += ',';
+    if (result.reachable >= 0) {
+        m_buffer += result.reachable ? "true," : "false,";
+        AppendNumber(result.hops);
+    } else {
+        m_buffer += ',';
+    }
+    m_buffer += ',';
+    if (result.shape >= 0 && !result.polyline) {
+        AppendShape(result, ',');
+    }
+    m_buffer += ',';
+    if (result.shape >= 0 && result.polyline) {
+        AppendShape(result, ',');
+    }
+    m_buffer += ',';
+    AppendQuoted(result.memory, ',');
+    m_buffer += '\n';
+}
+
+void BatchDriver::AppendNumber(long value) {
+    char digits[24]; // Sign and 20 digits of any 64-bit value
+    to_chars_result written = to_chars(digits, digits + sizeof(digits), value);
+    if (written.ec == errc()) {
+        m_buffer.append(digits, written.ptr - digits);
+    }
+}
+
+void BatchDriver::AppendMiles(double miles) {
+    // JSON has no nan or inf
+    if (!isfinite(miles)) {
+        m_buffer += m_format == BATCH_JSON ? "null" : "";
+        return;
+    }
+    char digits[320]; // Sign, 309 digits, point and 2 decimals of any double
+    to_chars_result written = to_chars(digits, digits + sizeof(digits), miles, chars_format::fixed, 2);
+    if (written.ec == errc()) {
+        m_buffer.append(digits, written.ptr - digits);
+    }
+}
+
+// JSON strings are always quoted and escaped; CSV fields are only quoted
+// when they contain a separator, quote or line break.
+void BatchDriver::AppendQuoted(string_view text, char quote) {
+    if (quote == '"') {
+        m_buffer += '"';
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c == '"' || c == '\\') {
+                m_buffer += '\\';
+                m_buffer += static_cast<char>(c);
+            } else if (c < 0x20) {
+                const char* hex = "0123456789abcdef";
+                m_buffer += "\\u00";
+                m_buffer += hex[c >> 4];
+                m_buffer += hex[c & 15];
+            } else {
+                m_buffer += static_cast<char>(c);
+            }
+        }
+        m_buffer += '"';
+        return;
+    }
+    if (text.find_first_of(",\"\n\r") == string_view::npos) {
+        m_buffer.append(text.data(), text.size());
+        return;
+    }
+    m_buffer += '"';
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '"') {
+            m_buffer += '"';
+        }
+        m_buffer += text[i];
+    }
+    m_buffer += '"';
+}
+
+void BatchDriver::AppendShape(const Result& result, char quote) {
+    size_t start = m_buffer.size();
+    m_navigator.AppendRouteShape(result.shape, result.spacing, result.polyline, m_buffer);
+    if (quote == '"' && !result.polyline) {
+        return; // GeoJSON is already JSON
+    }
+    QuoteFrom(start, quote);
+}
+
+void BatchDriver::QuoteFrom(size_t start, char quote) {
+    // Measure the quoted text, then fill it in from the back
+    size_t end = m_buffer.size();
+    size_t extra = 2;
+    bool needed = quote == '"';
+    for (size_t i = start; i < end; i++) {
+        unsigned char c = static_cast<unsigned char>(m_buffer[i]);
+        if (c == '"' || (quote == '"' && c == '\\')) {
+            extra++;
+        } else if (quote == '"' && c < 0x20) {
+            extra += 5;
+        }
+        needed = needed || c == ',' || c == '"' || c == '\n' || c == '\r';
+    }
+    if (!needed) {
+        return;
+    }
+    m_buffer.resize(end + extra);
+    size_t to = end + extra;
+    m_buffer[--to] = '"';
+    for (size_t i = end; i-- > start;) {
+        unsigned char c = static_cast<unsigned char>(m_buffer[i]);
+        if (quote == '"' && c < 0x20) {
+            const char* hex = "0123456789abcdef";
+            m_buffer[--to] = hex[c & 15];
+            m_buffer[--to] = hex[c >> 4];
+            m_buffer[--to] = '0';
+            m_buffer[--to] = '0';
+            m_buffer[--to] = 'u';
+            m_buffer[--to] = '\\';
+            continue;
+        }
+        m_buffer[--to] = static_cast<char>(c);
+        if (c == '"') {
+            m_buffer[--to] = quote == '"' ? '\\' : '"';
+        } else if (quote == '"' && c == '\\') {
+            m_buffer[--to] = '\\';
+        }
+    }
+    m_buffer[--to] = '"';
+}
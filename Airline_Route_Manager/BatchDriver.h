@@ -0,0 +1,180 @@
+//Name: BatchDriver.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the BatchDriver class
+//      The batch driver runs a Navigator without the menu. It reads one
+//      command per line from a script or stdin and writes one result per
+//      command as a JSON line or a CSV row. Results are collected in a
+//      buffer and written in large blocks (no flush per line).
+//
+//      Commands (airports are codes or 1-based numbers, routes 1-based):
+//        create AIRPORT AIRPORT [AIRPORT ...]
+//        score AIRPORT AIRPORT [AIRPORT ...]   (miles and legs; nothing stored)
+//        distance ROUTE            (also legs and shortest/longest leg)
+//        distance FROM TO          (miles between two airports)
+//        measure                   (totals over every route, in parallel)
+//        optimize ROUTE [fixed] [MS]   (reorder stops; fixed keeps the last)
+//        display ROUTE
+//        reverse ROUTE
+//        remove ROUTE AIRPORT      (AIRPORT is a code or a position)
+//        plan FROM TO RANGE        (RANGE 0 for unlimited)
+//        pareto FROM TO RANGE [HOPS]   (one result per miles/legs trade-off)
+//        reach FROM TO RANGE [HOPS]    (reachable within HOPS legs, fewest legs)
+//        shape ROUTE miles MILES|points N [polyline]   (great-circle GeoJSON,
+//                                                       at most BATCH_SHAPE_POINTS points)
+//        nearest AIRPORT K
+//        through AIRPORT [AIRPORT ...]   (routes passing through all)
+//        similar ROUTE K           (routes sharing at least K legs)
+//        hubs K                    (K most central airports of all routes)
+//        network                   (legs and connected components)
+//        ingest FILE [wait]        (add a flight-leg log in the background)
+//        legs [K]                  (ingested totals and K heaviest legs)
+//        leg FROM TO               (times a leg was ingested, estimated)
+//        stats [reset]             (memory; counters and timers with make STATS=1)
+//      Blank lines and lines starting with # are ignored.
+//      A read-only driver refuses the commands that change shared state
+//      (create, remove, reverse, optimize, ingest and stats reset); its
+//      plan returns the path without storing a route.
+
+#ifndef BATCHDRIVER_H
+#define BATCHDRIVER_H
+
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <vector>
+
+#include "Navigator.h"
+using namespace std;
+
+//Constants
+const size_t BATCH_BUFFER = 1 << 16; //Output bytes buffered before a write
+const long BATCH_SHAPE_POINTS = 1 << 18; //Most points in one shape answer
+
+//Output formats
+enum BatchFormat {
+  BATCH_JSON, //One JSON object per line
+  BATCH_CSV //Header row then one row per command
+};
+
+class BatchDriver {
+ public:
+  // Name: BatchDriver(Navigator&, ostream&, BatchFormat)
+  // Desc: Builds a driver that runs commands against navigator
+  // Preconditions: navigator is loaded
+  // Postconditions: Results will be written to out in format
+  BatchDriver(Navigator& navigator, ostream& out, BatchFormat format);
+  // Name: ~BatchDriver() - Destructor
+  // Desc: Writes any buffered output
+  // Preconditions: None
+  // Postconditions: Buffer is flushed
+  ~BatchDriver();
+  // Name: Run(istream&)
+  // Desc: Runs every command in the stream and writes its result
+  // Preconditions: None
+  // Postconditions: Returns the number of commands that failed
+  int Run(istream& in);
+  // Name: RunCommand(string_view, int)
+  // Desc: Runs a single command line (lineNumber is echoed in the result)
+  // Preconditions: None
+  // Postconditions: Returns false if the command failed
+  bool RunCommand(string_view line, int lineNumber);
+  // Name: RunCommand(string_view, int, string&)
+  // Desc: Runs a single command line and appends its result to out
+  //   instead of the stream (RouteServer answers each connection this way)
+  // Preconditions: None
+  // Postconditions: Returns false if the command failed
+  bool RunCommand(string_view line, int lineNumber, string& out);
+  // Name: SetReadOnly(bool)
+  // Desc: Refuses (or allows again) the commands that change shared state
+  // Preconditions: None
+  // Postconditions: Later commands are checked against readOnly
+  void SetReadOnly(bool readOnly);
+  // Name: Flush()
+  // Desc: Writes the buffered output to the stream
+  // Preconditions: None
+  // Postconditions: Buffer is empty
+  void Flush();
+ private:
+  //Result of one command; unset fields are left out of the output
+  struct Result {
+    int line; //Line number of the command
+    string_view command; //First word of the command
+    bool ok; //False if the command failed
+    int route; //1-based route number (0 if none)
+    double miles; //Route miles (negative if none)
+    int routes; //Routes measured (0 if none)
+    long legs; //Legs measured (negative if none)
+    double minLeg; //Shortest leg in miles
+    double maxLeg; //Longest leg in miles
+    vector<int> airports; //Airport ids in order
+    vector<double> distances; //Miles to each of airports (nearest)
+    vector<int> matches; //1-based route numbers found (through, similar)
+    vector<int> shared; //Legs each match shares (similar)
+    vector<int> degrees; //Airports linked to each of airports (hubs)
+    vector<double> betweenness; //Betweenness of each of airports (hubs)
+    vector<LegCount> top; //Heaviest ingested legs (legs)
+    long count; //Estimated times a leg was ingested (negative if none)
+    string name; //Route name (if route is set)
+    string stats; //Stats as a JSON object (stats)
+    string memory; //Memory usage as a JSON object (stats)
+    string network; //Network summary as a JSON object (network)
+    string ingest; //Ingestion totals as a JSON object (ingest, legs)
+    int reachable; //1 if reachable, 0 if not, negative if not asked (reach)
+    int hops; //Fewest legs (reach; -1 if never reachable)
+    int shape; //Route index written as a GeoJSON Feature (negative if none)
+    bool polyline; //Write shape as an encoded polyline instead
+    ShapeSpacing spacing; //How densely shape is sampled
+    string error; //Why the command failed
+  };
+  // Name: Execute(Result&)
+  // Desc: Runs the command in m_words and fills in result
+  void Execute(Result& result);
+  // Name: ParseAirport(string_view)
+  // Desc: Airport id of a code or 1-based number (-1 if not found)
+  int ParseAirport(string_view word);
+  // Name: ParseRoute(string_view, int&)
+  // Desc: Route at a 1-based number (nullptr if not found); sets index
+  Route* ParseRoute(string_view word, int& index);
+  // Name: ParseStops(Result&)
+  // Desc: Airport ids of every word after the command into m_ids
+  //   (false, with the error set, if one is not found)
+  bool ParseStops(Result& result);
+  // Name: SetStats(RouteStats&, Result&)
+  // Desc: Fills in miles, legs and shortest and longest leg
+  void SetStats(const RouteStats& stats, Result& result);
+  // Name: DescribeRoute(Route*, int, Result&)
+  // Desc: Fills in a route's number, name, airports and miles
+  void DescribeRoute(Route* route, int index, Result& result);
+  // Name: DescribeLegs(LegSnapshot&, Result&)
+  // Desc: Fills in the ingestion totals
+  void DescribeLegs(const LegSnapshot& snapshot, Result& result);
+  // Name: Write(Result&)
+  // Desc: Appends a result to m_buffer in m_format
+  void Write(const Result& result);
+  void WriteJSON(const Result& result);
+  void WriteCSV(const Result& result);
+  // Name: AppendNumber / AppendMiles / AppendQuoted
+  // Desc: Format values onto the end of m_buffer
+  void AppendNumber(long value);
+  void AppendMiles(double miles);
+  void AppendQuoted(string_view text, char quote);
+  // Name: AppendShape(Result&, char)
+  // Desc: Appends the route shape straight onto m_buffer, quoted in
+  //   place for CSV (and for a polyline in JSON) as AppendQuoted would
+  void AppendShape(const Result& result, char quote);
+  // Name: QuoteFrom(size_t, char)
+  // Desc: Quotes m_buffer from start on in place, as AppendQuoted would
+  void QuoteFrom(size_t start, char quote);
+  Navigator& m_navigator; //Navigator the commands run against
+  ostream& m_out; //Where results are written
+  BatchFormat m_format; //JSON lines or CSV
+  string m_buffer; //Results not yet written
+  bool m_capturing; //m_buffer is a caller's buffer, never written to m_out
+  bool m_readOnly; //Commands that change shared state are refused
+  Result m_result; //Reused for every command
+  vector<string_view> m_words; //Words of the current command
+  vector<int> m_ids; //Scratch airport ids
+};
+
+#endif
@@ -0,0 +1,130 @@
+//Name: BinaryHeap.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the BinaryHeap class
+//      An indexed binary min-heap over items 0..n-1 with decrease-key.
+//      Keys and heap positions live in flat arrays so a search touches
+//      no per-item allocations.
+
+#ifndef BINARYHEAP_H
+#define BINARYHEAP_H
+
+#include <vector>
+using namespace std;
+
+class BinaryHeap {
+ public:
+  // Name: BinaryHeap() - Default Constructor
+  // Desc: Builds an empty heap that can hold no items
+  // Preconditions: None
+  // Postconditions: Call Resize before use
+  BinaryHeap() {}
+  // Name: Resize(int)
+  // Desc: Allows items 0..capacity-1 and empties the heap
+  // Preconditions: None
+  // Postconditions: Heap is empty with room for capacity items
+  void Resize(int capacity) {
+    m_items.clear();
+    m_items.reserve(capacity);
+    m_keys.assign(capacity, 0.0);
+    m_position.assign(capacity, -1);
+  }
+  // Name: Clear()
+  // Desc: Empties the heap in O(size)
+  // Preconditions: None
+  // Postconditions: Heap is empty
+  void Clear() {
+    for (int i = 0; i < static_cast<int>(m_items.size()); i++) {
+      m_position[m_items[i]] = -1;
+    }
+    m_items.clear();
+  }
+  // Name: IsEmpty()
+  // Preconditions: None
+  // Postconditions: Returns true if no items are queued
+  bool IsEmpty() const {
+    return m_items.empty();
+  }
+  // Name: Contains(int)
+  // Preconditions: item < capacity
+  // Postconditions: Returns true if item is queued
+  bool Contains(int item) const {
+    return m_position[item] != -1;
+  }
+  // Name: Push(int, double)
+  // Desc: Queues item with key, or lowers its key if it is queued with
+  //   a larger key
+  // Preconditions: item < capacity
+  // Postconditions: item is queued with min(old key, key)
+  void Push(int item, double key) {
+    int position = m_position[item];
+    if (position == -1) {
+      position = static_cast<int>(m_items.size());
+      m_items.push_back(item);
+      m_position[item] = position;
+    } else if (key >= m_keys[item]) {
+      return;
+    }
+    m_keys[item] = key;
+    SiftUp(position);
+  }
+  // Name: Pop()
+  // Desc: Removes the item with the smallest key
+  // Preconditions: Heap is not empty
+  // Postconditions: Returns the removed item
+  int Pop() {
+    int top = m_items[0];
+    int last = m_items.back();
+    m_items.pop_back();
+    m_position[top] = -1;
+    if (!m_items.empty()) {
+      m_items[0] = last;
+      m_position[last] = 0;
+      SiftDown(0);
+    }
+    return top;
+  }
+ private:
+  void SiftUp(int position) {
+    int item = m_items[position];
+    double key = m_keys[item];
+    while (position > 0) {
+      int parent = (position - 1) / 2;
+      if (m_keys[m_items[parent]] <= key) {
+        break;
+      }
+      m_items[position] = m_items[parent];
+      m_position[m_items[position]] = position;
+      position = parent;
+    }
+    m_items[position] = item;
+    m_position[item] = position;
+  }
+  void SiftDown(int position) {
+    int size = static_cast<int>(m_items.size());
+    int item = m_items[position];
+    double key = m_keys[item];
+    while (true) {
+      int child = 2 * position + 1;
+      if (child >= size) {
+        break;
+      }
+      if (child + 1 < size && m_keys[m_items[child + 1]] < m_keys[m_items[child]]) {
+        child++;
+      }
+      if (key <= m_keys[m_items[child]]) {
+        break;
+      }
+      m_items[position] = m_items[child];
+      m_position[m_items[position]] = position;
+      position = child;
+    }
+    m_items[position] = item;
+    m_position[item] = position;
+  }
+  vector<int> m_items; //Heap-ordered items
+  vector<double> m_keys; //Key of each item
+  vector<int> m_position; //Position of each item in m_items (-1 if absent)
+};
+
+#endif
@@ -0,0 +1,128 @@
+//Name: Column.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the Column class template
+//      A column is an array that either owns its elements (a vector) or
+//      borrows them from memory it does not own, such as a memory-mapped
+//      snapshot. Reads work the same either way; the first write to a
+//      borrowed column copies it into owned storage.
+
+#ifndef COLUMN_H
+#define COLUMN_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+using namespace std;
+
+template <typename T>
+class Column {
+ public:
+  // Name: Column() - Default Constructor
+  // Desc: Builds an empty owned column
+  Column() : m_data(nullptr), m_size(0), m_borrowed(false) {}
+  // Name: Column(const Column&) - Copy Constructor
+  // Desc: Copies the elements into owned storage
+  Column(const Column& other) : m_data(nullptr), m_size(0), m_borrowed(false) {
+    m_owned.assign(other.m_data, other.m_data + other.m_size);
+    Sync();
+  }
+  // Name: operator=
+  // Desc: Copies the elements into owned storage
+  Column& operator=(const Column& other) {
+    if (this != &other) {
+      vector<T> copy(other.m_data, other.m_data + other.m_size);
+      m_owned.swap(copy);
+      Sync();
+    }
+    return *this;
+  }
+  // Name: Attach(const T*, size_t)
+  // Desc: Borrows size elements at data (nothing is copied)
+  // Preconditions: data stays valid and unchanged while attached
+  // Postconditions: Column reads from data
+  void Attach(const T* data, size_t size) {
+    vector<T>().swap(m_owned);
+    m_data = data;
+    m_size = size;
+    m_borrowed = true;
+  }
+  // Name: Adopt(vector<T>&)
+  // Desc: Takes the contents of values without copying
+  // Preconditions: None
+  // Postconditions: Column owns the elements; values is left empty
+  void Adopt(vector<T>& values) {
+    m_owned.swap(values);
+    vector<T>().swap(values);
+    Sync();
+  }
+  // Name: IsBorrowed()
+  // Postconditions: Returns true while reading memory the column does not own
+  bool IsBorrowed() const { return m_borrowed; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  const T* data() const { return m_data; }
+  const T& operator[](size_t index) const { return m_data[index]; }
+  const T& front() const { return m_data[0]; }
+  const T& back() const { return m_data[m_size - 1]; }
+  // Name: capacity()
+  // Postconditions: Returns owned capacity (0 while borrowed)
+  size_t capacity() const { return m_owned.capacity(); }
+  // Name: Set(size_t, T)
+  // Desc: Writes one element
+  void Set(size_t index, const T& value) {
+    Own();
+    m_owned[index] = value;
+  }
+  // Name: Append(const T*, size_t)
+  // Desc: Appends count elements copied from values
+  void Append(const T* values, size_t count) {
+    Own();
+    m_owned.insert(m_owned.end(), values, values + count);
+    Sync();
+  }
+  void push_back(const T& value) {
+    Own();
+    m_owned.push_back(value);
+    Sync();
+  }
+  void reserve(size_t count) {
+    Own();
+    m_owned.reserve(count);
+    Sync();
+  }
+  void resize(size_t count) {
+    Own();
+    m_owned.resize(count);
+    Sync();
+  }
+  void assign(size_t count, const T& value) {
+    m_owned.assign(count, value);
+    Sync();
+  }
+  void clear() {
+    m_owned.clear();
+    Sync();
+  }
+ private:
+  // Copies borrowed elements into owned storage
+  void Own() {
+    if (m_borrowed) {
+      vector<T> copy(m_data, m_data + m_size);
+      m_owned.swap(copy);
+      Sync();
+    }
+  }
+  // Points the read view at owned storage
+  void Sync() {
+    m_data = m_owned.data();
+    m_size = m_owned.size();
+    m_borrowed = false;
+  }
+  vector<T> m_owned; //Elements when owned
+  const T *m_data; //Elements being read (owned or borrowed)
+  size_t m_size; //Number of elements
+  bool m_borrowed; //True while m_data is not m_owned
+};
+
+#endif
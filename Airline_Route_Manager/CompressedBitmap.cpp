@@ -0,0 +1,231 @@
+#include "CompressedBitmap.h"
+
+#include <algorithm>
+#include <utility>
+
+CompressedBitmap::CompressedBitmap() {
+}
+
+int CompressedBitmap::Find(uint16_t key) const {
+    int low = 0;
+    int high = static_cast<int>(m_chunks.size());
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (m_chunks[middle].key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void CompressedBitmap::ToBits(Chunk& chunk) {
+    chunk.bits.assign(BITMAP_WORDS, 0);
+    for (int i = 0; i < static_cast<int>(chunk.array.size()); i++) {
+        chunk.bits[chunk.array[i] >> 6] |= 1ULL << (chunk.array[i] & 63);
+    }
+    vector<uint16_t>().swap(chunk.array);
+}
+
+void CompressedBitmap::ToArray(Chunk& chunk) {
+    chunk.array.clear();
+    chunk.array.reserve(chunk.count);
+    for (int word = 0; word < BITMAP_WORDS; word++) {
+        uint64_t bits = chunk.bits[word];
+        while (bits != 0) {
+            chunk.array.push_back(static_cast<uint16_t>(word * 64 + __builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+    vector<uint64_t>().swap(chunk.bits);
+}
+
+void CompressedBitmap::Add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    int index = Find(key);
+    if (index == static_cast<int>(m_chunks.size()) || m_chunks[index].key != key) {
+        Chunk chunk;
+        chunk.key = key;
+        chunk.count = 0;
+        m_chunks.insert(m_chunks.begin() + index, chunk);
+    }
+    Chunk& chunk = m_chunks[index];
+    if (!chunk.bits.empty()) {
+        uint64_t mask = 1ULL << (low & 63);
+        if ((chunk.bits[low >> 6] & mask) == 0) {
+            chunk.bits[low >> 6] |= mask;
+            chunk.count++;
+        }
+        return;
+    }
+    vector<uint16_t>::iterator position = lower_bound(chunk.array.begin(), chunk.array.end(), low);
+    if (position != chunk.array.end() && *position == low) {
+        return;
+    }
+    chunk.array.insert(position, low);
+    chunk.count++;
+    if (chunk.count > BITMAP_ARRAY_MAX) {
+        ToBits(chunk);
+    }
+}
+
+void CompressedBitmap::Remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    int index = Find(key);
+    if (index == static_cast<int>(m_chunks.size()) || m_chunks[index].key != key) {
+        return;
+    }
+    Chunk& chunk = m_chunks[index];
+    if (!chunk.bits.empty()) {
+        uint64_t mask = 1ULL << (low & 63);
+        if ((chunk.bits[low >> 6] & mask) == 0) {
+            return;
+        }
+        chunk.bits[low >> 6] &= ~mask;
+        chunk.count--;
+        if (chunk.count <= BITMAP_ARRAY_MAX) {
+            ToArray(chunk);
+        }
+    } else {
+        vector<uint16_t>::iterator position = lower_bound(chunk.array.begin(), chunk.array.end(), low);
+        if (position == chunk.array.end() || *position != low) {
+            return;
+        }
+        chunk.array.erase(position);
+        chunk.count--;
+    }
+    if (chunk.count == 0) {
+        m_chunks.erase(m_chunks.begin() + index);
+    }
+}
+
+bool CompressedBitmap::Contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+    int index = Find(key);
+    if (index == static_cast<int>(m_chunks.size()) || m_chunks[index].key != key) {
+        return false;
+    }
+    const Chunk& chunk = m_chunks[index];
+    if (!chunk.bits.empty()) {
+        return (chunk.bits[low >> 6] >> (low & 63)) & 1;
+    }
+    return binary_search(chunk.array.begin(), chunk.array.end(), low);
+}
+
+size_t CompressedBitmap::GetCount() const {
+    size_t count = 0;
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); i++) {
+        count += m_chunks[i].count;
+    }
+    return count;
+}
+
+bool CompressedBitmap::IsEmpty() const {
+    return m_chunks.empty();
+}
+
+void CompressedBitmap::AndChunk(Chunk& chunk, const Chunk& other) {
+    if (!chunk.bits.empty() && !other.bits.empty()) {
+        // Both dense: word by word
+        chunk.count = 0;
+        for (int word = 0; word < BITMAP_WORDS; word++) {
+            chunk.bits[word] &= other.bits[word];
+            chunk.count += __builtin_popcountll(chunk.bits[word]);
+        }
+        if (chunk.count <= BITMAP_ARRAY_MAX) {
+            ToArray(chunk);
+        }
+        return;
+    }
+    if (!chunk.bits.empty()) {
+        // Dense with sparse: the result is the sparse values that are set
+        vector<uint16_t> kept;
+        for (int i = 0; i < static_cast<int>(other.array.size()); i++) {
+            uint16_t low = other.array[i];
+            if ((chunk.bits[low >> 6] >> (low & 63)) & 1) {
+                kept.push_back(low);
+            }
+        }
+        chunk.array.swap(kept);
+        vector<uint64_t>().swap(chunk.bits);
+    } else if (!other.bits.empty()) {
+        int kept = 0;
+        for (int i = 0; i < static_cast<int>(chunk.array.size()); i++) {
+            uint16_t low = chunk.array[i];
+            if ((other.bits[low >> 6] >> (low & 63)) & 1) {
+                chunk.array[kept++] = low;
+            }
+        }
+        chunk.array.resize(kept);
+    } else {
+        // Both sparse: merge the sorted arrays in place
+        int kept = 0;
+        int j = 0;
+        int otherSize = static_cast<int>(other.array.size());
+        for (int i = 0; i < static_cast<int>(chunk.array.size()) && j < otherSize; i++) {
+            while (j < otherSize && other.array[j] < chunk.array[i]) {
+                j++;
+            }
+            if (j < otherSize && other.array[j] == chunk.array[i]) {
+                chunk.array[kept++] = chunk.array[i];
+            }
+        }
+        chunk.array.resize(kept);
+    }
+    chunk.count = static_cast<int>(chunk.array.size());
+}
+
+void CompressedBitmap::AndWith(const CompressedBitmap& other) {
+    int kept = 0;
+    int j = 0;
+    int otherSize = static_cast<int>(other.m_chunks.size());
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); i++) {
+        while (j < otherSize && other.m_chunks[j].key < m_chunks[i].key) {
+            j++;
+        }
+        if (j == otherSize || other.m_chunks[j].key != m_chunks[i].key) {
+            continue; // No values of this chunk are in other
+        }
+        AndChunk(m_chunks[i], other.m_chunks[j]);
+        if (m_chunks[i].count > 0) {
+            if (kept != i) {
+                m_chunks[kept] = move(m_chunks[i]);
+            }
+            kept++;
+        }
+    }
+    m_chunks.resize(kept);
+}
+
+void CompressedBitmap::ToVector(vector<uint32_t>& values) const {
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); i++) {
+        const Chunk& chunk = m_chunks[i];
+        uint32_t high = static_cast<uint32_t>(chunk.key) << 16;
+        if (chunk.bits.empty()) {
+            for (int j = 0; j < static_cast<int>(chunk.array.size()); j++) {
+                values.push_back(high | chunk.array[j]);
+            }
+            continue;
+        }
+        for (int word = 0; word < BITMAP_WORDS; word++) {
+            uint64_t bits = chunk.bits[word];
+            while (bits != 0) {
+                values.push_back(high | static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+size_t CompressedBitmap::GetMemoryUsage() const {
+    size_t bytes = m_chunks.capacity() * sizeof(Chunk);
+    for (int i = 0; i < static_cast<int>(m_chunks.size()); i++) {
+        bytes += m_chunks[i].array.capacity() * sizeof(uint16_t) +
+            m_chunks[i].bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
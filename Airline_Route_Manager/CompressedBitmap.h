@@ -0,0 +1,85 @@
+//Name: CompressedBitmap.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the CompressedBitmap class
+//      A set of 32-bit values split into chunks of 65536 by the high
+//      16 bits. A sparse chunk is a sorted array of the low 16 bits; a
+//      chunk with more than BITMAP_ARRAY_MAX values becomes a 65536-bit
+//      bitset. Small sets stay small and intersections work chunk by
+//      chunk with merges or word ANDs.
+
+#ifndef COMPRESSEDBITMAP_H
+#define COMPRESSEDBITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+//Constants
+const int BITMAP_ARRAY_MAX = 4096; //Most values in an array chunk
+const int BITMAP_WORDS = 1024; //64-bit words in a bitset chunk
+
+class CompressedBitmap {
+ public:
+  // Name: CompressedBitmap() - Default Constructor
+  // Desc: Builds an empty set
+  // Preconditions: None
+  // Postconditions: GetCount() is 0
+  CompressedBitmap();
+  // Name: Add(uint32_t)
+  // Preconditions: None
+  // Postconditions: value is in the set
+  void Add(uint32_t value);
+  // Name: Remove(uint32_t)
+  // Preconditions: None
+  // Postconditions: value is not in the set
+  void Remove(uint32_t value);
+  // Name: Contains(uint32_t)
+  // Preconditions: None
+  // Postconditions: Returns true if value is in the set
+  bool Contains(uint32_t value) const;
+  // Name: GetCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of values in the set
+  size_t GetCount() const;
+  // Name: IsEmpty()
+  // Preconditions: None
+  // Postconditions: Returns true if the set has no values
+  bool IsEmpty() const;
+  // Name: AndWith(CompressedBitmap&)
+  // Desc: Keeps only the values also in other
+  // Preconditions: None
+  // Postconditions: The set is the intersection
+  void AndWith(const CompressedBitmap& other);
+  // Name: ToVector(vector<uint32_t>&)
+  // Desc: Appends every value in increasing order
+  // Preconditions: None
+  // Postconditions: values holds the set's values after what it held
+  void ToVector(vector<uint32_t>& values) const;
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns the bytes allocated by the set
+  size_t GetMemoryUsage() const;
+ private:
+  //Values sharing the same high 16 bits
+  struct Chunk {
+    uint16_t key; //High 16 bits
+    int count; //Values in the chunk
+    vector<uint16_t> array; //Sorted low bits (array chunk)
+    vector<uint64_t> bits; //BITMAP_WORDS words (bitset chunk, else empty)
+  };
+  // Name: Find(uint16_t)
+  // Desc: Index of the first chunk with key >= key
+  int Find(uint16_t key) const;
+  // Name: ToBits(Chunk&) / ToArray(Chunk&)
+  // Desc: Switches a chunk's representation
+  static void ToBits(Chunk& chunk);
+  static void ToArray(Chunk& chunk);
+  // Name: AndChunk(Chunk&, Chunk&)
+  // Desc: Intersects chunk with other (same key) in place
+  static void AndChunk(Chunk& chunk, const Chunk& other);
+  vector<Chunk> m_chunks; //Non-empty chunks sorted by key
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "ConcurrentRoutes.h"
+
+#include <thread>
+#include <functional>
+
+ConcurrentRoutes::ReadGuard::ReadGuard(const ConcurrentRoutes& routes)
+    : m_routes(routes) {
+    m_slot = routes.Enter();
+    m_set = routes.m_current.load(memory_order_seq_cst);
+}
+
+ConcurrentRoutes::ReadGuard::~ReadGuard() {
+    m_routes.Exit(m_slot);
+}
+
+ConcurrentRoutes::ConcurrentRoutes() {
+    for (int i = 0; i < EPOCH_SLOTS; i++) {
+        m_slots[i].epoch.store(EPOCH_IDLE, memory_order_relaxed);
+    }
+    m_epoch.store(0, memory_order_relaxed);
+    RouteSet* empty = new RouteSet();
+    empty->version = 0;
+    m_current.store(empty, memory_order_seq_cst);
+}
+
+ConcurrentRoutes::~ConcurrentRoutes() {
+    for (int i = 0; i < static_cast<int>(m_retired.size()); i++) {
+        delete m_retired[i].set;
+    }
+    delete m_current.load(memory_order_relaxed);
+}
+
+int ConcurrentRoutes::Enter() const {
+    // Start where this thread's id hashes to so readers rarely collide
+    int start = static_cast<int>(hash<thread::id>()(this_thread::get_id()) % EPOCH_SLOTS);
+    while (true) {
+        for (int i = 0; i < EPOCH_SLOTS; i++) {
+            int slot = (start + i) % EPOCH_SLOTS;
+            uint64_t idle = EPOCH_IDLE;
+            // An epoch read before the pin can only be older than the
+            // current one, which just keeps sets a little longer
+            uint64_t epoch = m_epoch.load(memory_order_seq_cst);
+            if (m_slots[slot].epoch.load(memory_order_relaxed) == EPOCH_IDLE &&
+                m_slots[slot].epoch.compare_exchange_strong(idle, epoch, memory_order_seq_cst)) {
+                return slot;
+            }
+        }
+        this_thread::yield(); // Every slot is pinned
+    }
+}
+
+void ConcurrentRoutes::Exit(int slot) const {
+    m_slots[slot].epoch.store(EPOCH_IDLE, memory_order_release);
+}
+
+void ConcurrentRoutes::Publish(int index, shared_ptr<const RouteView> view) {
+    const RouteSet* current = m_current.load(memory_order_relaxed);
+    RouteSet* set = new RouteSet();
+    set->routes = current->routes;
+    if (index == static_cast<int>(set->routes.size())) {
+        set->routes.push_back(view);
+    } else {
+        set->routes[index] = view;
+    }
+    set->version = current->version + 1;
+    Swap(set);
+}
+
+void ConcurrentRoutes::PublishAll(const vector<shared_ptr<const RouteView> >& routes) {
+    RouteSet* set = new RouteSet();
+    set->routes = routes;
+    set->version = m_current.load(memory_order_relaxed)->version + 1;
+    Swap(set);
+}
+
+// Readers that pinned epoch e or earlier may hold the old set; anyone
+// pinning after the epoch moves on loads the new one.
+void ConcurrentRoutes::Swap(RouteSet* set) {
+    const RouteSet* old = m_current.exchange(set, memory_order_seq_cst);
+    Retired retired = {old, m_epoch.load(memory_order_relaxed)};
+    m_retired.push_back(retired);
+    m_epoch.fetch_add(1, memory_order_seq_cst);
+    Collect();
+}
+
+void ConcurrentRoutes::Collect() {
+    uint64_t oldest = EPOCH_IDLE;
+    for (int i = 0; i < EPOCH_SLOTS; i++) {
+        uint64_t epoch = m_slots[i].epoch.load(memory_order_seq_cst);
+        if (epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    int kept = 0;
+    for (int i = 0; i < static_cast<int>(m_retired.size()); i++) {
+        if (m_retired[i].epoch < oldest) {
+            delete m_retired[i].set;
+        } else {
+            m_retired[kept++] = m_retired[i];
+        }
+    }
+    m_retired.resize(kept);
+}
+
+int ConcurrentRoutes::GetRetiredCount() const {
+    return static_cast<int>(m_retired.size());
+}
@@ -0,0 +1,124 @@
+//Name: ConcurrentRoutes.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the ConcurrentRoutes class
+//      Routes published for readers on other threads, RCU style. Readers
+//      see an immutable RouteSet (one RouteView per route). A writer never
+//      changes a published set: it builds a new one and swaps the pointer
+//      in, so a reader never waits and never sees a half-made edit.
+//      Retired sets are freed by epochs. A reader pins the global epoch
+//      in one of EPOCH_SLOTS slots while it holds a set. A set retired
+//      in epoch e is freed once no pinned slot is at or below e. Entering
+//      and leaving are an atomic load, a compare-exchange and a store;
+//      there are no locks on the read side. Writers are serialized by
+//      the caller.
+
+#ifndef CONCURRENTROUTES_H
+#define CONCURRENTROUTES_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+using namespace std;
+
+//Constants
+const int EPOCH_SLOTS = 256; //Most readers holding a set at once
+const uint64_t EPOCH_IDLE = UINT64_MAX; //Slot value when no reader holds it
+
+//Immutable copy of one route
+struct RouteView {
+  vector<int> stops; //Airport ids in order
+  vector<double> legs; //legs[i] is the miles from stops[i] to stops[i + 1]
+  double miles; //Route's running total (Route::GetDistance)
+  string name; //Route's name
+};
+
+//Immutable list of every route at one moment
+struct RouteSet {
+  vector<shared_ptr<const RouteView> > routes; //Index as in m_routes
+  long version; //Number of the publish that made this set
+};
+
+class ConcurrentRoutes {
+ public:
+  //Pins the current set while it is in scope (one per reader at a time)
+  class ReadGuard {
+   public:
+    // Name: ReadGuard(ConcurrentRoutes&)
+    // Desc: Pins an epoch and loads the current set
+    // Preconditions: Fewer than EPOCH_SLOTS other guards, or it spins
+    // Postconditions: Get() stays valid until the guard is destroyed
+    explicit ReadGuard(const ConcurrentRoutes& routes);
+    ~ReadGuard();
+    // Name: Get()
+    // Preconditions: None
+    // Postconditions: Returns the set current when the guard was made
+    const RouteSet& Get() const { return *m_set; }
+   private:
+    ReadGuard(const ReadGuard&); //Not copyable
+    ReadGuard& operator=(const ReadGuard&); //Not assignable
+    const ConcurrentRoutes& m_routes; //Whose epoch is pinned
+    int m_slot; //Slot holding the pinned epoch
+    const RouteSet* m_set; //Set loaded after pinning
+  };
+  // Name: ConcurrentRoutes() - Default Constructor
+  // Desc: Publishes an empty set
+  // Preconditions: None
+  // Postconditions: Readers see no routes
+  ConcurrentRoutes();
+  // Name: ~ConcurrentRoutes() - Destructor
+  // Desc: Frees the current set and every retired one
+  // Preconditions: No reader holds a guard
+  // Postconditions: All memory is freed
+  ~ConcurrentRoutes();
+  // Name: Publish(int, shared_ptr<const RouteView>)
+  // Desc: Publishes a set with route index replaced (or appended if
+  //   index is the route count); every other route is shared, not copied
+  // Preconditions: 0 <= index <= route count; one writer at a time
+  // Postconditions: New readers see the new set; old sets are freed
+  //   once their readers leave
+  void Publish(int index, shared_ptr<const RouteView> view);
+  // Name: PublishAll(vector<shared_ptr<const RouteView> >&)
+  // Desc: Publishes a set holding exactly routes
+  // Preconditions: One writer at a time
+  // Postconditions: New readers see the new set
+  void PublishAll(const vector<shared_ptr<const RouteView> >& routes);
+  // Name: GetRetiredCount()
+  // Desc: Sets retired but still waiting for readers to leave
+  // Preconditions: Called by the writer
+  // Postconditions: Returns the count
+  int GetRetiredCount() const;
+ private:
+  //One reader slot on its own cache line
+  struct alignas(64) Slot {
+    atomic<uint64_t> epoch; //Pinned epoch or EPOCH_IDLE
+  };
+  //A set that readers may still hold
+  struct Retired {
+    const RouteSet* set; //Set swapped out
+    uint64_t epoch; //Epoch it was swapped out in
+  };
+  // Name: Enter()
+  // Desc: Pins the current epoch in a free slot
+  // Postconditions: Returns the slot
+  int Enter() const;
+  // Name: Exit(int)
+  // Desc: Unpins a slot
+  void Exit(int slot) const;
+  // Name: Swap(RouteSet*)
+  // Desc: Makes set current, retires the old one and frees what it can
+  void Swap(RouteSet* set);
+  // Name: Collect()
+  // Desc: Frees every retired set no pinned reader can hold
+  void Collect();
+  ConcurrentRoutes(const ConcurrentRoutes&); //Not copyable
+  ConcurrentRoutes& operator=(const ConcurrentRoutes&); //Not assignable
+  atomic<const RouteSet*> m_current; //Set new readers get
+  atomic<uint64_t> m_epoch; //Advanced by every publish
+  mutable Slot m_slots[EPOCH_SLOTS]; //Epochs pinned by readers
+  vector<Retired> m_retired; //Swapped-out sets not yet freed (writer only)
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "CountMinSketch.h"
+
+CountMinSketch::CountMinSketch(int width, int depth) {
+    m_width = 1;
+    while (m_width < width) {
+        m_width <<= 1;
+    }
+    m_depth = depth < SKETCH_MAX_DEPTH ? depth : SKETCH_MAX_DEPTH;
+    m_mask = static_cast<uint64_t>(m_width) - 1;
+    m_total = 0;
+    m_counters.assign(static_cast<size_t>(m_width) * m_depth, 0);
+}
+
+uint64_t CountMinSketch::Mix(uint64_t key) {
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+// Row r uses h1 + r * h2 (two hashes are enough for every row:
+// Kirsch and Mitzenmacher)
+void CountMinSketch::Add(uint64_t key, uint64_t count) {
+    uint64_t h1 = Mix(key);
+    uint64_t h2 = Mix(h1) | 1;
+    uint64_t* cells[SKETCH_MAX_DEPTH];
+    uint64_t smallest = UINT64_MAX;
+    for (int r = 0; r < m_depth; r++) {
+        cells[r] = &m_counters[static_cast<size_t>(r) * m_width + ((h1 + r * h2) & m_mask)];
+        if (*cells[r] < smallest) {
+            smallest = *cells[r];
+        }
+    }
+    // Conservative update: no counter needs to pass the new estimate
+    uint64_t target = smallest + count;
+    for (int r = 0; r < m_depth; r++) {
+        if (*cells[r] < target) {
+            *cells[r] = target;
+        }
+    }
+    m_total += count;
+}
+
+uint64_t CountMinSketch::Estimate(uint64_t key) const {
+    uint64_t h1 = Mix(key);
+    uint64_t h2 = Mix(h1) | 1;
+    uint64_t smallest = UINT64_MAX;
+    for (int r = 0; r < m_depth; r++) {
+        uint64_t cell = m_counters[static_cast<size_t>(r) * m_width + ((h1 + r * h2) & m_mask)];
+        if (cell < smallest) {
+            smallest = cell;
+        }
+    }
+    return smallest;
+}
+
+uint64_t CountMinSketch::GetTotal() const {
+    return m_total;
+}
+
+void CountMinSketch::Clear() {
+    m_counters.assign(m_counters.size(), 0);
+    m_total = 0;
+}
+
+size_t CountMinSketch::GetMemoryUsage() const {
+    return m_counters.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,65 @@
+//Name: CountMinSketch.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the CountMinSketch class
+//      Approximate counts of 64-bit keys in fixed memory: depth rows of
+//      width counters, each row indexed by its own hash of the key. An
+//      estimate is the smallest of the key's counters, so it is never
+//      below the true count and is above it by at most total / width * e
+//      with probability 1 - e^-depth. Adds are conservative (only the
+//      counters that would otherwise fall behind are raised), which
+//      tightens the estimates without breaking that bound.
+
+#ifndef COUNTMINSKETCH_H
+#define COUNTMINSKETCH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+//Constants
+const int SKETCH_WIDTH = 1 << 14; //Default counters per row (power of two)
+const int SKETCH_DEPTH = 4; //Default rows
+const int SKETCH_MAX_DEPTH = 32; //Most rows
+
+class CountMinSketch {
+ public:
+  // Name: CountMinSketch(int, int) - Overloaded Constructor
+  // Desc: Builds an empty sketch; width is rounded up to a power of two
+  // Preconditions: width >= 1 and 1 <= depth <= SKETCH_MAX_DEPTH
+  // Postconditions: Every estimate is 0
+  CountMinSketch(int width = SKETCH_WIDTH, int depth = SKETCH_DEPTH);
+  // Name: Add(uint64_t, uint64_t)
+  // Desc: Counts count more occurrences of key
+  // Preconditions: None
+  // Postconditions: Estimate(key) has grown by at least count
+  void Add(uint64_t key, uint64_t count);
+  // Name: Estimate(uint64_t)
+  // Preconditions: None
+  // Postconditions: Returns an upper bound on key's count
+  uint64_t Estimate(uint64_t key) const;
+  // Name: GetTotal()
+  // Preconditions: None
+  // Postconditions: Returns the sum of every count added
+  uint64_t GetTotal() const;
+  // Name: Clear()
+  // Preconditions: None
+  // Postconditions: Every estimate is 0
+  void Clear();
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns the bytes used by the counters
+  size_t GetMemoryUsage() const;
+ private:
+  // Name: Mix(uint64_t)
+  // Desc: Spreads the bits of key (splitmix64 finalizer)
+  static uint64_t Mix(uint64_t key);
+  int m_width; //Counters per row
+  int m_depth; //Rows
+  uint64_t m_mask; //m_width - 1
+  uint64_t m_total; //Sum of every count added
+  vector<uint64_t> m_counters; //Row r is [r * m_width, (r + 1) * m_width)
+};
+
+#endif
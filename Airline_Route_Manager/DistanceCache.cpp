@@ -0,0 +1,84 @@
+#include "DistanceCache.h"
+#include <cstdlib>
+
+DistanceCache::DistanceCache() {
+    m_matrix = nullptr;
+    m_size = 0;
+    m_bytes = 0;
+    m_owned = true;
+}
+
+DistanceCache::~DistanceCache() {
+    Clear();
+}
+
+double* DistanceCache::AllocateAligned(size_t count) {
+    // aligned_alloc requires the size to be a multiple of the alignment
+    size_t bytes = count * sizeof(double);
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    if (bytes == 0) {
+        bytes = CACHE_LINE;
+    }
+    return static_cast<double*>(aligned_alloc(CACHE_LINE, bytes));
+}
+
+bool DistanceCache::Build(const AirportCatalog& catalog) {
+    Clear();
+    int size = catalog.GetSize();
+    if (size < 2 || size > DISTANCE_CACHE_MAX) {
+        return false;
+    }
+
+    size_t entries = (size_t)size * (size - 1) / 2;
+    m_matrix = AllocateAligned(entries);
+    if (m_matrix == nullptr) {
+        return false;
+    }
+    m_size = size;
+    m_bytes = entries * sizeof(double);
+
+    const double* norths = catalog.GetNorths();
+    const double* wests = catalog.GetWests();
+
+    // Row i of the packed matrix is contiguous, so each row is one batch
+    // of airport i against every airport after it
+    for (int i = 0; i < size - 1; i++) {
+        BatchDistanceFrom(norths[i], wests[i], &norths[i + 1], &wests[i + 1],
+                          m_matrix + Index(i, i + 1), size - i - 1);
+    }
+    return true;
+}
+
+void DistanceCache::Attach(const double* matrix, int size) {
+    Clear();
+    // Never written or freed while attached
+    m_matrix = const_cast<double*>(matrix);
+    m_size = size;
+    m_owned = false;
+}
+
+void DistanceCache::Clear() {
+    if (m_owned) {
+        free(m_matrix);
+    }
+    m_matrix = nullptr;
+    m_size = 0;
+    m_bytes = 0;
+    m_owned = true;
+}
+
+bool DistanceCache::IsBuilt() const {
+    return m_matrix != nullptr;
+}
+
+int DistanceCache::GetSize() const {
+    return m_size;
+}
+
+size_t DistanceCache::GetEntryCount() const {
+    return (size_t)m_size * (m_size > 0 ? m_size - 1 : 0) / 2;
+}
+
+size_t DistanceCache::GetMemoryUsage() const {
+    return m_bytes;
+}
@@ -0,0 +1,109 @@
+//Name: DistanceCache.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the DistanceCache class
+//      The cache holds the great-circle distance between every pair of
+//      airports in the Navigator's airport table so route legs can be
+//      looked up without any trig
+
+#ifndef DISTANCECACHE_H
+#define DISTANCECACHE_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+
+#include "AirportCatalog.h"
+#include "Haversine.h"
+using namespace std;
+
+//Constants
+const int DISTANCE_CACHE_MAX = 5000; //Largest table cached (~100MB of distances)
+const size_t CACHE_LINE = 64; //Alignment of the cache arrays in bytes
+
+class DistanceCache {
+ public:
+  // Name: DistanceCache() - Default Constructor
+  // Desc: Used to build a new, empty distance cache
+  // Preconditions: None
+  // Postconditions: Creates a cache with no airports (IsBuilt is false)
+  DistanceCache();
+  // Name: ~DistanceCache() - Destructor
+  // Desc: Frees the distance matrix
+  // Preconditions: None
+  // Postconditions: All cache memory is deallocated
+  ~DistanceCache();
+  // Name: Build(AirportCatalog&)
+  // Desc: Computes the distance between every pair of airports and
+  //   stores it in a packed upper-triangular matrix indexed by the
+  //   airport's id in the catalog. Rows are filled with
+  //   BatchDistanceFrom (within HAVERSINE_MAX_ULP of
+  //   Navigator::CalcDistance).
+  //   Tables larger than DISTANCE_CACHE_MAX are not cached.
+  // Preconditions: Airports are loaded
+  // Postconditions: Returns true if the cache was built
+  bool Build(const AirportCatalog& catalog);
+  // Name: Clear()
+  // Desc: Frees all cache memory
+  // Preconditions: None
+  // Postconditions: Cache is empty and IsBuilt is false
+  void Clear();
+  // Name: IsBuilt()
+  // Desc: Returns whether distances have been precomputed
+  // Preconditions: None
+  // Postconditions: Returns true if GetDistance can be used
+  bool IsBuilt() const;
+  // Name: GetDistance(int, int)
+  // Desc: Returns the distance in miles between two airports by id
+  // Preconditions: IsBuilt() and both ids are in [0, GetSize())
+  // Postconditions: Returns the cached distance (0 for the same airport)
+  double GetDistance(int id1, int id2) const {
+    if (id1 == id2) {
+      return 0.0;
+    }
+    if (id1 > id2) {
+      int temp = id1;
+      id1 = id2;
+      id2 = temp;
+    }
+    return m_matrix[Index(id1, id2)];
+  }
+  // Name: GetSize()
+  // Desc: Returns the number of airports in the cache
+  // Preconditions: None
+  // Postconditions: Returns m_size
+  int GetSize() const;
+  // Name: GetEntryCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of pairs in the matrix
+  size_t GetEntryCount() const;
+  // Name: GetMemoryUsage()
+  // Desc: Returns the number of bytes allocated by the cache
+  //   (0 while it reads a memory-mapped snapshot)
+  // Preconditions: None
+  // Postconditions: Returns the footprint of the matrix
+  size_t GetMemoryUsage() const;
+ private:
+  // Name: Index(int, int)
+  // Desc: Position of pair (i, j) with i < j in the packed matrix
+  //   Row i holds the pairs (i, i+1) ... (i, n-1)
+  size_t Index(int i, int j) const {
+    return (size_t)i * (2 * (size_t)m_size - i - 1) / 2 + (j - i - 1);
+  }
+  // Name: AllocateAligned(size_t)
+  // Desc: Allocates count doubles on a cache line boundary
+  static double* AllocateAligned(size_t count);
+  DistanceCache(const DistanceCache&); //Not copyable
+  DistanceCache& operator=(const DistanceCache&); //Not assignable
+  // Name: Attach(const double*, int)
+  // Desc: Reads a matrix stored elsewhere (a memory-mapped snapshot)
+  //   instead of allocating it
+  void Attach(const double* matrix, int size);
+  double *m_matrix; //Packed upper-triangular distances (miles)
+  int m_size; //Number of airports in the cache
+  size_t m_bytes; //Total bytes allocated
+  bool m_owned; //False while the matrix belongs to a snapshot
+  friend class Snapshot; //Saves and attaches the matrix
+};
+
+#endif
@@ -0,0 +1,180 @@
+//Name: DistanceModel.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: Distance models and units chosen at compile time. A model is a
+//      class with a static Distance(north1, west1, north2, west2) in
+//      degrees, templated on a unit, so callers pick one as a template
+//      argument and the call is resolved (and usually inlined) with no
+//      virtual dispatch:
+//        HaversineModel       great circle on a sphere (the default;
+//                             same numbers as Haversine and CalcDistance)
+//        EquirectangularModel flat-map approximation: one cos and a sqrt.
+//                             Close for short legs, never shorter than the
+//                             great circle, up to ~1.9x longer near the poles.
+//        VincentyModel        geodesic on the WGS-84 ellipsoid (about 0.5%
+//                             different from the sphere; iterative)
+//        ChordModel           straight line through the earth. Never longer
+//                             than the great circle, so it is safe for
+//                             pruning; from precomputed unit vectors it
+//                             needs no trig.
+//      LOWER_BOUND is true for models that never exceed the great circle.
+
+#ifndef DISTANCEMODEL_H
+#define DISTANCEMODEL_H
+
+#include <cmath>
+
+#include "Haversine.h"
+
+//Constants
+const double METERS_PER_MILE = 1609.344;
+const double WGS84_A = 6378137.0; //Equatorial radius (meters)
+const double WGS84_F = 1.0 / 298.257223563; //Flattening
+const int VINCENTY_ITERATIONS = 200; //Most iterations before falling back
+const double VINCENTY_TOLERANCE = 1e-12; //Change in lambda (radians) that ends the loop
+
+//Units: PER_MILE converts miles into the unit
+struct Miles {
+  static constexpr double PER_MILE = 1.0;
+  static constexpr const char* NAME = "mi";
+};
+struct Kilometers {
+  static constexpr double PER_MILE = 1.609344;
+  static constexpr const char* NAME = "km";
+};
+struct NauticalMiles {
+  static constexpr double PER_MILE = 1.609344 / 1.852;
+  static constexpr const char* NAME = "nm";
+};
+
+// Name: Convert<From, To>(double)
+// Desc: Converts a distance between units
+template <class From, class To>
+constexpr double Convert(double distance) {
+  return distance * (To::PER_MILE / From::PER_MILE);
+}
+
+// Name: EarthRadius<Unit>()
+// Desc: Radius of the sphere the spherical models use
+template <class Unit>
+constexpr double EarthRadius() {
+  return double(EARTH_RADIUS) * Unit::PER_MILE;
+}
+
+//A point on the unit sphere (for ChordModel)
+struct UnitVector {
+  double x;
+  double y;
+  double z;
+};
+
+template <class Unit>
+struct HaversineModel {
+  static constexpr bool LOWER_BOUND = true;
+  static double Distance(double north1, double west1, double north2, double west2) {
+    return Haversine(north1, west1, north2, west2) * Unit::PER_MILE;
+  }
+};
+
+template <class Unit>
+struct EquirectangularModel {
+  static constexpr bool LOWER_BOUND = false;
+  static double Distance(double north1, double west1, double north2, double west2) {
+    double west = west1 - west2;
+    // Take the short way around the date line
+    if (west > 180.0) {
+      west -= 360.0;
+    } else if (west < -180.0) {
+      west += 360.0;
+    }
+    double x = west * DEG_2_RAD * std::cos((north1 + north2) * 0.5 * DEG_2_RAD);
+    double y = (north1 - north2) * DEG_2_RAD;
+    return EarthRadius<Unit>() * std::sqrt(x * x + y * y);
+  }
+};
+
+template <class Unit>
+struct ChordModel {
+  static constexpr bool LOWER_BOUND = true;
+  // Name: Point(double, double)
+  // Desc: Unit vector of a point in degrees
+  static UnitVector Point(double north, double west) {
+    double cosNorth = std::cos(north * DEG_2_RAD);
+    UnitVector point = {cosNorth * std::cos(west * DEG_2_RAD),
+                        cosNorth * std::sin(west * DEG_2_RAD),
+                        std::sin(north * DEG_2_RAD)};
+    return point;
+  }
+  // Name: Between(UnitVector&, UnitVector&)
+  // Desc: Chord between two precomputed points (no trig)
+  static double Between(const UnitVector& a, const UnitVector& b) {
+    double x = a.x - b.x;
+    double y = a.y - b.y;
+    double z = a.z - b.z;
+    return EarthRadius<Unit>() * std::sqrt(x * x + y * y + z * z);
+  }
+  static double Distance(double north1, double west1, double north2, double west2) {
+    return Between(Point(north1, west1), Point(north2, west2));
+  }
+};
+
+template <class Unit>
+struct VincentyModel {
+  static constexpr bool LOWER_BOUND = false;
+  static double Distance(double north1, double west1, double north2, double west2) {
+    const double b = WGS84_A * (1.0 - WGS84_F);
+    double u1 = std::atan((1.0 - WGS84_F) * std::tan(north1 * DEG_2_RAD));
+    double u2 = std::atan((1.0 - WGS84_F) * std::tan(north2 * DEG_2_RAD));
+    double sinU1 = std::sin(u1), cosU1 = std::cos(u1);
+    double sinU2 = std::sin(u2), cosU2 = std::cos(u2);
+    double l = (west2 - west1) * DEG_2_RAD;
+    double lambda = l;
+    double sinSigma = 0.0, cosSigma = 0.0, sigma = 0.0;
+    double cosSqAlpha = 0.0, cos2SigmaM = 0.0;
+    int iteration = 0;
+    for (; iteration < VINCENTY_ITERATIONS; iteration++) {
+      double sinLambda = std::sin(lambda), cosLambda = std::cos(lambda);
+      double p = cosU2 * sinLambda;
+      double q = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+      sinSigma = std::sqrt(p * p + q * q);
+      if (sinSigma == 0.0) {
+        return 0.0; // Same point
+      }
+      cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+      sigma = std::atan2(sinSigma, cosSigma);
+      double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+      cosSqAlpha = 1.0 - sinAlpha * sinAlpha;
+      // On the equator cosSqAlpha is 0 and so is this term
+      cos2SigmaM = cosSqAlpha != 0.0 ? cosSigma - 2.0 * sinU1 * sinU2 / cosSqAlpha : 0.0;
+      double c = WGS84_F / 16.0 * cosSqAlpha * (4.0 + WGS84_F * (4.0 - 3.0 * cosSqAlpha));
+      double previous = lambda;
+      lambda = l + (1.0 - c) * WGS84_F * sinAlpha *
+        (sigma + c * sinSigma * (cos2SigmaM + c * cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM)));
+      if (std::fabs(lambda - previous) < VINCENTY_TOLERANCE) {
+        break;
+      }
+    }
+    if (iteration == VINCENTY_ITERATIONS) {
+      // Nearly antipodal points may not converge; use the sphere
+      return HaversineModel<Unit>::Distance(north1, west1, north2, west2);
+    }
+    double uSq = cosSqAlpha * (WGS84_A * WGS84_A - b * b) / (b * b);
+    double bigA = 1.0 + uSq / 16384.0 * (4096.0 + uSq * (-768.0 + uSq * (320.0 - 175.0 * uSq)));
+    double bigB = uSq / 1024.0 * (256.0 + uSq * (-128.0 + uSq * (74.0 - 47.0 * uSq)));
+    double deltaSigma = bigB * sinSigma * (cos2SigmaM + bigB / 4.0 *
+      (cosSigma * (-1.0 + 2.0 * cos2SigmaM * cos2SigmaM) -
+       bigB / 6.0 * cos2SigmaM * (-3.0 + 4.0 * sinSigma * sinSigma) *
+       (-3.0 + 4.0 * cos2SigmaM * cos2SigmaM)));
+    double meters = b * bigA * (sigma - deltaSigma);
+    return meters / METERS_PER_MILE * Unit::PER_MILE;
+  }
+};
+
+// Name: ModelDistance<Model>(double, double, double, double)
+// Desc: Distance between two points in degrees under Model
+template <class Model>
+inline double ModelDistance(double north1, double west1, double north2, double west2) {
+  return Model::Distance(north1, west1, north2, west2);
+}
+
+#endif
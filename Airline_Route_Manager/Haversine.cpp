@@ -0,0 +1,124 @@
+#include "HaversineKernel.h"
+#include <cstdlib>
+
+//Defined in HaversineAVX2.cpp (built with -mavx2)
+#ifdef __x86_64__
+void BatchDistanceAVX2(const double* north1, const double* west1,
+                       const double* north2, const double* west2,
+                       double* miles, int count);
+void BatchDistanceFromAVX2(double north, double west,
+                           const double* norths, const double* wests,
+                           double* miles, int count);
+void GreatCircleAVX2(const GreatCircleLeg& leg, int first, int count,
+                     double* norths, double* wests);
+#endif
+
+namespace {
+
+typedef void (*BatchFunction)(const double*, const double*, const double*,
+                              const double*, double*, int);
+typedef void (*BatchFromFunction)(double, double, const double*,
+                                  const double*, double*, int);
+typedef void (*GreatCircleFunction)(const GreatCircleLeg&, int, int, double*, double*);
+
+// The three code paths available on this machine
+struct BatchPath {
+  const char* name;
+  BatchFunction batch;
+  BatchFromFunction batchFrom;
+  GreatCircleFunction greatCircle;
+};
+
+const BatchPath SCALAR_PATH = {"scalar", BatchLanes<double>, BatchFromLanes<double>,
+                               GreatCircleLanes<double>};
+const BatchPath SSE2_PATH = {"sse2", BatchLanes<Vec2>, BatchFromLanes<Vec2>,
+                             GreatCircleLanes<Vec2>};
+#ifdef __x86_64__
+const BatchPath AVX2_PATH = {"avx2", BatchDistanceAVX2, BatchDistanceFromAVX2,
+                             GreatCircleAVX2};
+#endif
+
+// Picks the widest path the CPU supports (or the one named in ARM_SIMD)
+const BatchPath* SelectPath() {
+  const char* forced = getenv("ARM_SIMD");
+  const char* request = forced == nullptr ? "" : forced;
+  if (strcmp(request, "scalar") == 0) {
+    return &SCALAR_PATH;
+  }
+#ifdef __x86_64__
+  __builtin_cpu_init();
+  if (strcmp(request, "sse2") != 0 && __builtin_cpu_supports("avx2")) {
+    return &AVX2_PATH;
+  }
+#endif
+  return &SSE2_PATH;
+}
+
+// Resolved once on first use
+const BatchPath* ActivePath() {
+  static const BatchPath* path = SelectPath();
+  return path;
+}
+
+}
+
+double Haversine(double north1, double west1, double north2, double west2) {
+    return HaversineLanes(north1, west1, north2, west2);
+}
+
+void BatchDistance(const double* north1, const double* west1,
+                   const double* north2, const double* west2,
+                   double* miles, int count) {
+    ActivePath()->batch(north1, west1, north2, west2, miles, count);
+}
+
+void BatchDistanceFrom(double north, double west,
+                       const double* norths, const double* wests,
+                       double* miles, int count) {
+    ActivePath()->batchFrom(north, west, norths, wests, miles, count);
+}
+
+void GreatCirclePoints(double north1, double west1, double north2, double west2,
+                       int steps, int first, int count, double* norths, double* wests) {
+    GreatCircleLeg leg;
+    double lat1 = north1 * DEG_2_RAD;
+    double lng1 = west1 * DEG_2_RAD;
+    double lat2 = north2 * DEG_2_RAD;
+    double lng2 = west2 * DEG_2_RAD;
+    leg.start[0] = cos(lat1) * cos(lng1);
+    leg.start[1] = cos(lat1) * sin(lng1);
+    leg.start[2] = sin(lat1);
+    leg.end[0] = cos(lat2) * cos(lng2);
+    leg.end[1] = cos(lat2) * sin(lng2);
+    leg.end[2] = sin(lat2);
+    // atan2 of |a x b| and a . b stays accurate for short legs
+    double cx = leg.start[1] * leg.end[2] - leg.start[2] * leg.end[1];
+    double cy = leg.start[2] * leg.end[0] - leg.start[0] * leg.end[2];
+    double cz = leg.start[0] * leg.end[1] - leg.start[1] * leg.end[0];
+    double sine = sqrt(cx * cx + cy * cy + cz * cz);
+    double dot = leg.start[0] * leg.end[0] + leg.start[1] * leg.end[1] + leg.start[2] * leg.end[2];
+    leg.angle = atan2(sine, dot);
+    leg.step = 1.0 / steps;
+    if (sine < GREAT_CIRCLE_MIN_SINE) {
+        for (int i = 0; i < count; i++) {
+            double t = (first + i) * leg.step;
+            norths[i] = north1 + (north2 - north1) * t;
+            wests[i] = west1 + (west2 - west1) * t;
+        }
+    } else {
+        leg.scale = 1.0 / sine;
+        ActivePath()->greatCircle(leg, first, count, norths, wests);
+    }
+    if (count > 0 && first == 0) {
+        norths[0] = north1;
+        wests[0] = west1;
+    }
+    if (count > 0 && first + count == steps + 1) {
+        norths[count - 1] = north2;
+        wests[count - 1] = west2;
+    }
+}
+
+const char* BatchDistancePath() {
+    return ActivePath()->name;
+}
@@ -0,0 +1,76 @@
+//Name: Haversine.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the batch haversine
+//      functions. They compute many great-circle distances in one pass over
+//      structure-of-arrays coordinates (separate north and west arrays)
+//      using AVX2 or SSE2 when the CPU supports it, and interpolate
+//      points along great circles the same way.
+
+#ifndef HAVERSINE_H
+#define HAVERSINE_H
+
+//Constants used for calculating distance
+#define PI 3.14159265358979323846
+#define EARTH_RADIUS 3958.8 //in miles
+#define DEG_2_RAD PI / 180
+#define RAD_2_DEG 180 / PI
+
+//Every path (scalar, SSE2, AVX2) returns the same bits for the same input.
+//The polynomial sin, cos and atan2 are within 2 ulp of libm. Compared with
+//Navigator::CalcDistance, legs under HAVERSINE_ULP_RANGE miles differ by at
+//most HAVERSINE_MAX_ULP units in the last place. Closer to antipodal the
+//formula itself is ill-conditioned and the relative difference grows to
+//about 1e-9 (a few inches on a 12,000 mile leg).
+const int HAVERSINE_MAX_ULP = 8;
+const double HAVERSINE_ULP_RANGE = 10000.0;
+//Below this sine of the central angle the ends have no unique great circle
+const double GREAT_CIRCLE_MIN_SINE = 1e-12;
+
+// Name: Haversine
+// Desc: Scalar version of the batch kernel for a single pair
+// Preconditions: Coordinates in degrees
+// Postconditions: Returns distance in miles between the two points
+double Haversine(double north1, double west1, double north2, double west2);
+
+// Name: BatchDistance
+// Desc: miles[i] = distance from (north1[i], west1[i]) to
+//   (north2[i], west2[i]) for i in [0, count)
+// Preconditions: All arrays hold at least count entries (no alignment needed)
+// Postconditions: miles is populated
+void BatchDistance(const double* north1, const double* west1,
+                   const double* north2, const double* west2,
+                   double* miles, int count);
+
+// Name: BatchDistanceFrom
+// Desc: miles[i] = distance from (north, west) to (norths[i], wests[i])
+//   Used to score one airport against many candidates
+// Preconditions: All arrays hold at least count entries
+// Postconditions: miles is populated
+void BatchDistanceFrom(double north, double west,
+                       const double* norths, const double* wests,
+                       double* miles, int count);
+
+// Name: GreatCirclePoints
+// Desc: Of the steps + 1 evenly spaced points along the great circle from
+//   (north1, west1) to (north2, west2), writes points first ..
+//   first + count - 1 to norths and wests (point 0 is the start and
+//   point steps the end, both exact). Slerps unit vectors on the same
+//   code path as BatchDistance. Returned wests are in (-180, 180].
+//   Coincident or antipodal ends (no unique great circle) are joined by
+//   straight interpolation of the coordinates.
+// Preconditions: steps >= 1, first >= 0, first + count <= steps + 1 and
+//   both arrays hold at least count entries
+// Postconditions: norths and wests are populated
+void GreatCirclePoints(double north1, double west1, double north2, double west2,
+                       int steps, int first, int count, double* norths, double* wests);
+
+// Name: BatchDistancePath
+// Desc: Returns the code path chosen at runtime ("avx2", "sse2" or "scalar")
+//   Setting the environment variable ARM_SIMD to one of these names
+//   before the first call forces that path (if the CPU supports it)
+// Preconditions: None
+// Postconditions: Returns the name of the path in use
+const char* BatchDistancePath();
+
+#endif
@@ -0,0 +1,22 @@
+//Compiled with -mavx2 (see makefile). Only reached through Haversine.cpp
+//after checking that the CPU supports AVX2.
+#include "HaversineKernel.h"
+
+#ifdef __AVX2__
+void BatchDistanceAVX2(const double* north1, const double* west1,
+                       const double* north2, const double* west2,
+                       double* miles, int count) {
+    BatchLanes<Vec4>(north1, west1, north2, west2, miles, count);
+}
+
+void BatchDistanceFromAVX2(double north, double west,
+                           const double* norths, const double* wests,
+                           double* miles, int count) {
+    BatchFromLanes<Vec4>(north, west, norths, wests, miles, count);
+}
+
+void GreatCircleAVX2(const GreatCircleLeg& leg, int first, int count,
+                     double* norths, double* wests) {
+    GreatCircleLanes<Vec4>(leg, first, count, norths, wests);
+}
+#endif
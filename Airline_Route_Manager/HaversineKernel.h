@@ -0,0 +1,310 @@
+//Name: HaversineKernel.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the haversine kernel shared by every code path
+//      of BatchDistance. The kernel is written once as a template over a
+//      "lane" type (double, or a GCC vector of doubles) and only uses
+//      +, -, *, / and sqrt, so the scalar, SSE2 and AVX2 paths round
+//      identically and return the same bits for the same inputs.
+//      The same lanes also interpolate points along great circles
+//      (GreatCirclePoints).
+//      Only included by Haversine.cpp and HaversineAVX2.cpp.
+
+#ifndef HAVERSINEKERNEL_H
+#define HAVERSINEKERNEL_H
+
+#include <cstring>
+#include <cmath>
+
+#include "Haversine.h"
+
+//One great circle prepared by GreatCirclePoints for the lanes below
+struct GreatCircleLeg {
+  double start[3]; //Unit vector of the first point
+  double end[3]; //Unit vector of the last point
+  double angle; //Central angle between them in radians
+  double scale; //1 / sin(angle)
+  double step; //Fraction of the leg between neighbouring points
+};
+
+//Everything here has internal linkage on purpose: HaversineAVX2.cpp is
+//compiled with -mavx2 and its copies must never replace the baseline ones.
+namespace {
+
+//Lane types (GCC vector extensions)
+typedef double Vec2 __attribute__((vector_size(16)));
+typedef long long Mask2 __attribute__((vector_size(16)));
+typedef double Vec4 __attribute__((vector_size(32)));
+typedef long long Mask4 __attribute__((vector_size(32)));
+
+//Mask type that goes with each lane type
+template <typename V> struct MaskOf;
+template <> struct MaskOf<double> { typedef long long Type; };
+template <> struct MaskOf<Vec2> { typedef Mask2 Type; };
+template <> struct MaskOf<Vec4> { typedef Mask4 Type; };
+
+//Cody-Waite split of PI/2 (Cephes DP1..DP3 doubled)
+const double PIO2_1 = 1.57079625129699707031E0;
+const double PIO2_2 = 7.54978941586159635335E-8;
+const double PIO2_3 = 5.39030285815811905290E-15;
+const double PIO2 = 1.57079632679489661923;
+const double PIO4 = 7.85398163397448309616E-1;
+const double MOREBITS = 6.123233995736765886130E-17; //PI/2 - PIO2
+const double TWO_OVER_PI = 6.36619772367581343076E-1;
+const double ROUND_MAGIC = 6755399441055744.0; //1.5 * 2^52
+const long long SIGN_MASK = -0x7fffffffffffffffLL - 1; //Sign bit of a double
+
+//Bit casts between lanes and masks
+template <typename V>
+inline typename MaskOf<V>::Type Bits(V value) {
+  typename MaskOf<V>::Type bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+template <typename V>
+inline V FromBits(typename MaskOf<V>::Type bits) {
+  V value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+//All ones where a > b, zero elsewhere
+inline long long Greater(double a, double b) { return a > b ? -1LL : 0LL; }
+inline Mask2 Greater(Vec2 a, Vec2 b) { return a > b; }
+#ifdef __AVX2__
+inline Mask4 Greater(Vec4 a, Vec4 b) { return a > b; }
+#endif
+
+//mask ? a : b, lane by lane
+template <typename V>
+inline V Select(typename MaskOf<V>::Type mask, V a, V b) {
+  return FromBits<V>((mask & Bits(a)) | (~mask & Bits(b)));
+}
+
+//Lane broadcast of a scalar constant
+template <typename V>
+inline V Splat(double value) {
+  return V{} + value;
+}
+template <>
+inline double Splat<double>(double value) {
+  return value;
+}
+
+//Correctly rounded square root on every path
+inline double Sqrt(double value) { return std::sqrt(value); }
+#ifdef __SSE2__
+inline Vec2 Sqrt(Vec2 value) { return __builtin_ia32_sqrtpd(value); }
+#else
+inline Vec2 Sqrt(Vec2 value) { return Vec2{std::sqrt(value[0]), std::sqrt(value[1])}; }
+#endif
+#ifdef __AVX2__
+inline Vec4 Sqrt(Vec4 value) { return __builtin_ia32_sqrtpd256(value); }
+#endif
+
+template <typename V>
+inline V Min(V a, V b) { return Select(Greater(a, b), b, a); }
+template <typename V>
+inline V Max(V a, V b) { return Select(Greater(a, b), a, b); }
+
+// Name: SinQuadrant
+// Desc: sin(x + quadrantShift * PI/2) using a quadrant reduction and the
+//   Cephes sin/cos polynomials on [-PI/4, PI/4]
+template <typename V>
+inline V SinQuadrant(V x, long long quadrantShift) {
+  typedef typename MaskOf<V>::Type M;
+  V shifted = x * TWO_OVER_PI + ROUND_MAGIC;
+  V n = shifted - ROUND_MAGIC;
+  //The low bits of the rounded value hold the quadrant
+  M quadrant = Bits(shifted) + quadrantShift;
+  V r = ((x - n * PIO2_1) - n * PIO2_2) - n * PIO2_3;
+  V z = r * r;
+
+  V sinPoly = Splat<V>(1.58962301576546568060E-10);
+  sinPoly = sinPoly * z + -2.50507477628578072866E-8;
+  sinPoly = sinPoly * z + 2.75573136213857245213E-6;
+  sinPoly = sinPoly * z + -1.98412698295895385996E-4;
+  sinPoly = sinPoly * z + 8.33333333332211858878E-3;
+  sinPoly = sinPoly * z + -1.66666666666666307295E-1;
+  V sinR = r + r * (z * sinPoly);
+
+  V cosPoly = Splat<V>(-1.13585365213876817300E-11);
+  cosPoly = cosPoly * z + 2.08757008419747316778E-9;
+  cosPoly = cosPoly * z + -2.75573141792967388112E-7;
+  cosPoly = cosPoly * z + 2.48015872888517045348E-5;
+  cosPoly = cosPoly * z + -1.38888888888730564116E-3;
+  cosPoly = cosPoly * z + 4.16666666666665929218E-2;
+  V cosR = (1.0 - z * 0.5) + z * z * cosPoly;
+
+  M odd = -(quadrant & 1);
+  V result = Select(odd, cosR, sinR);
+  //Quadrants 2 and 3 flip the sign (a mask, as shifting into the sign
+  //bit of a signed lane is undefined)
+  M sign = -((quadrant >> 1) & 1) & SIGN_MASK;
+  return FromBits<V>(Bits(result) ^ sign);
+}
+
+// Name: Atan2Positive
+// Desc: atan2(y, x) for y >= 0, x >= 0 (not both zero) using the Cephes
+//   atan rational approximation after reducing to [0, 1]
+template <typename V>
+inline V Atan2Positive(V y, V x) {
+  typedef typename MaskOf<V>::Type M;
+  M swapped = Greater(y, x);
+  V t = Min(y, x) / Max(y, x);
+
+  //Reduce [0.66, 1] to (-0.2, 0] around PI/4
+  M upper = Greater(t, Splat<V>(0.66));
+  V reduced = Select(upper, (t - 1.0) / (t + 1.0), t);
+  V base = Select(upper, Splat<V>(PIO4), Splat<V>(0.0));
+  V extra = Select(upper, Splat<V>(0.5 * MOREBITS), Splat<V>(0.0));
+
+  V z = reduced * reduced;
+  V p = Splat<V>(-8.750608600031904122785E-1);
+  p = p * z + -1.615753718733365076637E1;
+  p = p * z + -7.500855792314704667340E1;
+  p = p * z + -1.228866684490136173410E2;
+  p = p * z + -6.485021904942025371773E1;
+  V q = z + 2.485846490142306297962E1;
+  q = q * z + 1.650270098316988542046E2;
+  q = q * z + 4.328810604912902668951E2;
+  q = q * z + 4.853903996359136964868E2;
+  q = q * z + 1.945506571482613964425E2;
+  V angle = base + ((reduced * (z * p / q) + extra) + reduced);
+
+  //atan(y/x) = PI/2 - atan(x/y) when y > x
+  return Select(swapped, (PIO2 - angle) + MOREBITS, angle);
+}
+
+//|value| and the sign bit of value
+template <typename V>
+inline V Abs(V value) {
+  return FromBits<V>(Bits(value) & ~SIGN_MASK);
+}
+template <typename V>
+inline typename MaskOf<V>::Type SignBit(V value) {
+  return Bits(value) & SIGN_MASK;
+}
+
+// Name: Atan2Lanes
+// Desc: atan2(y, x) in (-PI, PI] from Atan2Positive; 0 when both are 0
+template <typename V>
+inline V Atan2Lanes(V y, V x) {
+  V absY = Abs(y);
+  V absX = Abs(x);
+  typename MaskOf<V>::Type zero = ~Greater(absY + absX, Splat<V>(0.0));
+  V angle = Atan2Positive(absY, Select(zero, Splat<V>(1.0), absX));
+  angle = Select(Greater(Splat<V>(0.0), x), PI - angle, angle);
+  return FromBits<V>(Bits(angle) ^ SignBit(y));
+}
+
+// Name: HaversineLanes
+// Desc: Great-circle distance in miles for each lane. Same formula as
+//   Navigator::CalcDistance with the polynomial sin/cos/atan2 above.
+template <typename V>
+inline V HaversineLanes(V north1, V west1, V north2, V west2) {
+  V lat_new = north2 * PI / 180;
+  V lat_old = north1 * PI / 180;
+  V lat_diff = (north1 - north2) * PI / 180;
+  V lng_diff = (west1 - west2) * PI / 180;
+
+  V sinLat = SinQuadrant(lat_diff / 2, 0);
+  V sinLng = SinQuadrant(lng_diff / 2, 0);
+  V a = sinLat * sinLat +
+    SinQuadrant(lat_new, 1) * SinQuadrant(lat_old, 1) *
+    sinLng * sinLng;
+  a = Min(a, Splat<V>(1.0));
+  V c = 2.0 * Atan2Positive(Sqrt(a), Sqrt(1.0 - a));
+
+  return double(EARTH_RADIUS) * c;
+}
+
+//Unaligned loads and stores of a full lane
+template <typename V>
+inline V Load(const double* source) {
+  V value;
+  memcpy(&value, source, sizeof(value));
+  return value;
+}
+
+template <typename V>
+inline void Store(double* target, V value) {
+  memcpy(target, &value, sizeof(value));
+}
+
+// Name: BatchLanes / BatchFromLanes
+// Desc: Runs the kernel over count entries, sizeof(V)/8 lanes at a time,
+//   finishing the tail with the scalar kernel
+template <typename V>
+inline void BatchLanes(const double* north1, const double* west1,
+                       const double* north2, const double* west2,
+                       double* miles, int count) {
+  const int lanes = sizeof(V) / sizeof(double);
+  int i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    Store(miles + i, HaversineLanes(Load<V>(north1 + i), Load<V>(west1 + i),
+                                    Load<V>(north2 + i), Load<V>(west2 + i)));
+  }
+  for (; i < count; i++) {
+    miles[i] = HaversineLanes(north1[i], west1[i], north2[i], west2[i]);
+  }
+}
+
+// Name: GreatCircleLanes
+// Desc: Points first .. first + count - 1 of a prepared great circle.
+//   Point i is the slerp of the end vectors at t = i * step, turned back
+//   into degrees north and west.
+template <typename V>
+inline void GreatCircleLanes(const GreatCircleLeg& leg, int first, int count,
+                             double* norths, double* wests) {
+  static const double OFFSETS[4] = {0.0, 1.0, 2.0, 3.0};
+  const int lanes = sizeof(V) / sizeof(double);
+  V offsets = Load<V>(OFFSETS);
+  int i = 0;
+  for (; i < count; i += lanes) {
+    V t = (Splat<V>(first + i) + offsets) * leg.step;
+    V startWeight = SinQuadrant((1.0 - t) * leg.angle, 0) * leg.scale;
+    V endWeight = SinQuadrant(t * leg.angle, 0) * leg.scale;
+    V x = startWeight * leg.start[0] + endWeight * leg.end[0];
+    V y = startWeight * leg.start[1] + endWeight * leg.end[1];
+    V z = startWeight * leg.start[2] + endWeight * leg.end[2];
+    V north = Atan2Lanes(z, Sqrt(x * x + y * y)) * RAD_2_DEG;
+    V west = Atan2Lanes(y, x) * RAD_2_DEG;
+    if (i + lanes <= count) {
+      Store(norths + i, north);
+      Store(wests + i, west);
+    } else {
+      //Tail: keep only the lanes that are in range
+      double northLanes[lanes];
+      double westLanes[lanes];
+      Store(northLanes, north);
+      Store(westLanes, west);
+      for (int lane = 0; i + lane < count; lane++) {
+        norths[i + lane] = northLanes[lane];
+        wests[i + lane] = westLanes[lane];
+      }
+    }
+  }
+}
+
+template <typename V>
+inline void BatchFromLanes(double north, double west,
+                           const double* norths, const double* wests,
+                           double* miles, int count) {
+  const int lanes = sizeof(V) / sizeof(double);
+  V north1 = Splat<V>(north);
+  V west1 = Splat<V>(west);
+  int i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    Store(miles + i, HaversineLanes(north1, west1,
+                                    Load<V>(norths + i), Load<V>(wests + i)));
+  }
+  for (; i < count; i++) {
+    miles[i] = HaversineLanes(north, west, norths[i], wests[i]);
+  }
+}
+
+}
+
+#endif
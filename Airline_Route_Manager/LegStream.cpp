@@ -0,0 +1,295 @@
+#include "LegStream.h"
+#include "Haversine.h"
+#include "Stats.h"
+
+LegStream::LegStream(const AirportCatalog& catalog, const DistanceCache& cache)
+    : m_catalog(catalog), m_cache(cache), m_running(false), m_stopping(false),
+      m_heavy(LEG_MONITORED) {
+    m_queueLimit = LEG_QUEUE_CHUNKS;
+    m_readDone = true;
+    m_active = 0;
+    m_lines = 0;
+    m_legs = 0;
+    m_skipped = 0;
+    m_miles = 0.0;
+    m_sinceSnapshot = 0;
+    lock_guard<mutex> lock(m_lock);
+    Publish(true);
+}
+
+LegStream::~LegStream() {
+    {
+        lock_guard<mutex> lock(m_queueLock);
+        m_stopping = true;
+    }
+    m_queued.notify_all();
+    m_taken.notify_all();
+    Wait();
+}
+
+uint64_t LegStream::LegKey(int from, int to) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) | static_cast<uint32_t>(to);
+}
+
+bool LegStream::Start(const string& fileName, int threads) {
+    Wait();
+    m_file.clear();
+    m_file.open(fileName.c_str(), ios::binary);
+    if (!m_file.is_open()) {
+        return false;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    m_chunks.clear();
+    m_queueLimit = LEG_QUEUE_CHUNKS * threads;
+    m_readDone = false;
+    m_active = threads;
+    m_running = true;
+    m_reader = thread(&LegStream::ReadLoop, this);
+    for (int i = 0; i < threads; i++) {
+        m_aggregators.push_back(thread(&LegStream::AggregateLoop, this));
+    }
+    return true;
+}
+
+void LegStream::Wait() {
+    if (m_reader.joinable()) {
+        m_reader.join();
+    }
+    for (int i = 0; i < static_cast<int>(m_aggregators.size()); i++) {
+        m_aggregators[i].join();
+    }
+    m_aggregators.clear();
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+bool LegStream::IsRunning() const {
+    return m_running;
+}
+
+shared_ptr<const LegSnapshot> LegStream::GetSnapshot() const {
+    return atomic_load(&m_snapshot);
+}
+
+long LegStream::Estimate(int from, int to) const {
+    lock_guard<mutex> lock(m_lock);
+    return static_cast<long>(m_sketch.Estimate(LegKey(from, to)));
+}
+
+size_t LegStream::GetMemoryUsage() const {
+    lock_guard<mutex> lock(m_lock);
+    return m_sketch.GetMemoryUsage();
+}
+
+void LegStream::Clear() {
+    Wait();
+    lock_guard<mutex> lock(m_lock);
+    m_sketch.Clear();
+    m_heavy.Clear();
+    m_lines = 0;
+    m_legs = 0;
+    m_skipped = 0;
+    m_miles = 0.0;
+    Publish(true);
+}
+
+void LegStream::ReadLoop() {
+    string carry; //Start of a line cut off by the last chunk
+    bool discarding = false; //Inside a line longer than a chunk
+    while (true) {
+        string chunk;
+        {
+            unique_lock<mutex> lock(m_queueLock);
+            m_taken.wait(lock, [this]() {
+                return static_cast<int>(m_chunks.size()) < m_queueLimit || m_stopping;
+            });
+            if (m_stopping) {
+                break;
+            }
+            if (!m_spare.empty()) {
+                chunk.swap(m_spare.back());
+                m_spare.pop_back();
+            }
+        }
+        chunk.assign(carry);
+        carry.clear();
+        size_t start = chunk.size();
+        chunk.resize(start + LEG_CHUNK_BYTES);
+        m_file.read(&chunk[start], LEG_CHUNK_BYTES);
+        size_t got = static_cast<size_t>(m_file.gcount());
+        chunk.resize(start + got);
+        bool end = got < LEG_CHUNK_BYTES;
+        if (discarding) {
+            // Drop the rest of an overlong line
+            size_t first = chunk.find('\n');
+            discarding = first == string::npos;
+            chunk.erase(0, discarding ? string::npos : first + 1);
+        }
+        if (!end && !discarding && !chunk.empty()) {
+            // Hand on only whole lines; the rest starts the next chunk
+            size_t last = chunk.rfind('\n');
+            if (last == string::npos) {
+                // One line longer than a chunk: skip it rather than let
+                // carry grow past LEG_CHUNK_BYTES
+                discarding = true;
+                chunk.clear();
+                lock_guard<mutex> lock(m_lock);
+                m_lines++;
+                m_skipped++;
+            } else {
+                carry.assign(chunk, last + 1, string::npos);
+                chunk.resize(last + 1);
+            }
+        }
+        {
+            lock_guard<mutex> lock(m_queueLock);
+            if (!chunk.empty()) {
+                m_chunks.push_back(string());
+                m_chunks.back().swap(chunk);
+            } else {
+                m_spare.push_back(string());
+                m_spare.back().swap(chunk);
+            }
+        }
+        m_queued.notify_one();
+        if (end) {
+            break;
+        }
+    }
+    {
+        lock_guard<mutex> lock(m_queueLock);
+        m_readDone = true;
+    }
+    m_queued.notify_all();
+}
+
+void LegStream::AggregateLoop() {
+    unordered_map<uint64_t, long> legs; //This chunk's leg counts
+    string chunk;
+    while (true) {
+        {
+            unique_lock<mutex> lock(m_queueLock);
+            m_queued.wait(lock, [this]() {
+                return !m_chunks.empty() || m_readDone || m_stopping;
+            });
+            if (m_chunks.empty() || m_stopping) {
+                break;
+            }
+            chunk.swap(m_chunks.front());
+            m_chunks.pop_front();
+        }
+        m_taken.notify_one();
+
+        {
+            STATS_TIMER(STAT_INGEST);
+            long lines = 0;
+            long skipped = 0;
+            legs.clear();
+            Parse(chunk, legs, lines, skipped);
+            Merge(legs, lines, skipped);
+        }
+
+        lock_guard<mutex> lock(m_queueLock);
+        m_spare.push_back(string());
+        m_spare.back().swap(chunk);
+    }
+
+    bool last = false;
+    {
+        lock_guard<mutex> lock(m_queueLock);
+        last = --m_active == 0;
+    }
+    if (last) {
+        lock_guard<mutex> lock(m_lock);
+        Publish(true);
+        m_running = false;
+    }
+}
+
+void LegStream::Parse(const string& chunk, unordered_map<uint64_t, long>& legs,
+                      long& lines, long& skipped) const {
+    const char* text = chunk.data();
+    size_t size = chunk.size();
+    size_t i = 0;
+    while (i < size) {
+        size_t end = chunk.find('\n', i);
+        if (end == string::npos) {
+            end = size;
+        }
+        // Up to two fields between separators
+        string_view fields[2];
+        int count = 0;
+        size_t j = i;
+        while (j < end && count < 2) {
+            while (j < end && (text[j] == ' ' || text[j] == '\t' || text[j] == ',' || text[j] == '\r')) {
+                j++;
+            }
+            size_t start = j;
+            while (j < end && text[j] != ' ' && text[j] != '\t' && text[j] != ',' && text[j] != '\r') {
+                j++;
+            }
+            if (j > start) {
+                fields[count++] = string_view(text + start, j - start);
+            }
+        }
+        i = end + 1;
+        if (count == 0 || fields[0][0] == '#') {
+            continue; // Blank lines and comments are not counted
+        }
+        lines++;
+        int from = count == 2 ? m_catalog.FindCode(fields[0]) : -1;
+        int to = count == 2 ? m_catalog.FindCode(fields[1]) : -1;
+        if (from < 0 || to < 0 || from == to) {
+            skipped++;
+            continue;
+        }
+        legs[LegKey(from, to)]++;
+    }
+}
+
+void LegStream::Merge(const unordered_map<uint64_t, long>& legs, long lines, long skipped) {
+    lock_guard<mutex> lock(m_lock);
+    for (unordered_map<uint64_t, long>::const_iterator leg = legs.begin(); leg != legs.end(); ++leg) {
+        m_sketch.Add(leg->first, leg->second);
+        m_heavy.Add(leg->first, leg->second);
+        // Miles once per distinct leg in the chunk
+        m_miles += leg->second * Miles(static_cast<int>(leg->first >> 32),
+                                       static_cast<int>(leg->first & 0xffffffffULL));
+        m_legs += leg->second;
+    }
+    m_lines += lines;
+    m_skipped += skipped;
+    if (++m_sinceSnapshot >= LEG_SNAPSHOT_CHUNKS) {
+        Publish(false);
+    }
+}
+
+void LegStream::Publish(bool done) {
+    shared_ptr<LegSnapshot> snapshot = make_shared<LegSnapshot>();
+    snapshot->lines = m_lines;
+    snapshot->legs = m_legs;
+    snapshot->skipped = m_skipped;
+    snapshot->miles = m_miles;
+    snapshot->done = done;
+    vector<HeavyHitter> top;
+    m_heavy.Top(LEG_TOP_K, top);
+    for (int i = 0; i < static_cast<int>(top.size()); i++) {
+        LegCount leg = {static_cast<int>(top[i].key >> 32),
+                        static_cast<int>(top[i].key & 0xffffffffULL),
+                        static_cast<long>(top[i].count), static_cast<long>(top[i].error)};
+        snapshot->top.push_back(leg);
+    }
+    atomic_store(&m_snapshot, shared_ptr<const LegSnapshot>(snapshot));
+    m_sinceSnapshot = 0;
+}
+
+double LegStream::Miles(int from, int to) const {
+    if (m_cache.IsBuilt()) {
+        return m_cache.GetDistance(from, to);
+    }
+    return Haversine(m_catalog.GetNorth(from), m_catalog.GetWest(from),
+                     m_catalog.GetNorth(to), m_catalog.GetWest(to));
+}
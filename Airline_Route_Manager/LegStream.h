@@ -0,0 +1,167 @@
+//Name: LegStream.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the LegStream class
+//      Ingests logs of observed flight legs, one "ORIGIN DESTINATION"
+//      pair of airport codes per line (spaces, tabs or commas between;
+//      later fields are ignored). Logs can be far larger than memory, so
+//      only summaries are kept:
+//        a CountMinSketch of every directed leg (count of any leg)
+//        a SpaceSaving summary of the heaviest legs (top k)
+//        totals of lines, legs, skipped lines and miles flown
+//      A reader thread cuts the file into LEG_CHUNK_BYTES chunks at line
+//      ends and queues them (at most LEG_QUEUE_CHUNKS at once, buffers
+//      reused); aggregator threads parse a chunk into a local table of
+//      leg counts and merge it into the summaries under one lock. Every
+//      LEG_SNAPSHOT_CHUNKS chunks (and at the end) a LegSnapshot is
+//      published that readers fetch without waiting on the ingestion.
+//      A line longer than a chunk is dropped and counted as skipped.
+//      Counts accumulate across files until Clear.
+
+#ifndef LEGSTREAM_H
+#define LEGSTREAM_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <fstream>
+#include <cstdint>
+
+#include "AirportCatalog.h"
+#include "DistanceCache.h"
+#include "CountMinSketch.h"
+#include "SpaceSaving.h"
+using namespace std;
+
+//Constants
+const size_t LEG_CHUNK_BYTES = 1 << 20; //Bytes read per chunk
+const int LEG_QUEUE_CHUNKS = 4; //Most chunks waiting per aggregator
+const int LEG_SNAPSHOT_CHUNKS = 16; //Chunks merged between snapshots
+const int LEG_TOP_K = 100; //Heaviest legs kept in a snapshot
+const int LEG_MONITORED = 4 * LEG_TOP_K; //Legs SpaceSaving monitors
+
+//One heavy leg in a snapshot
+struct LegCount {
+  int from; //Origin airport id
+  int to; //Destination airport id
+  long count; //Upper bound on the times the leg was flown
+  long error; //count - error is a lower bound
+};
+
+//Totals and heaviest legs at one moment of the ingestion
+struct LegSnapshot {
+  long lines; //Lines read (not counting blank lines and comments)
+  long legs; //Lines that were a leg between two known airports
+  long skipped; //Lines with an unknown code or one code
+  double miles; //Total miles of every leg
+  bool done; //True once the last file has been read
+  vector<LegCount> top; //Heaviest legs, most flown first
+};
+
+class LegStream {
+ public:
+  // Name: LegStream(AirportCatalog&, DistanceCache&)
+  // Desc: Builds an empty stream; codes are looked up in catalog and
+  //   miles come from cache when it is built (else Haversine)
+  // Preconditions: catalog and cache outlive the stream
+  // Postconditions: GetSnapshot returns an empty, done snapshot
+  LegStream(const AirportCatalog& catalog, const DistanceCache& cache);
+  // Name: ~LegStream() - Destructor
+  // Desc: Stops any ingestion and joins its threads
+  // Preconditions: None
+  // Postconditions: No threads are running
+  ~LegStream();
+  // Name: Start(string&, int)
+  // Desc: Starts ingesting fileName on a reader and threads aggregators
+  //   and returns at once. Waits for any earlier file to finish first.
+  // Preconditions: threads >= 1
+  // Postconditions: Returns false if the file cannot be opened
+  bool Start(const string& fileName, int threads);
+  // Name: Wait()
+  // Desc: Waits for the current file to be fully ingested
+  // Preconditions: None
+  // Postconditions: The last snapshot is published with done set
+  void Wait();
+  // Name: IsRunning()
+  // Preconditions: None
+  // Postconditions: Returns true while a file is being ingested
+  bool IsRunning() const;
+  // Name: GetSnapshot()
+  // Desc: The last published snapshot (never blocks on ingestion)
+  // Preconditions: None
+  // Postconditions: Returns a snapshot that stays valid while held
+  shared_ptr<const LegSnapshot> GetSnapshot() const;
+  // Name: Estimate(int, int)
+  // Desc: Times the leg from -> to was flown, from the sketch (never
+  //   below the truth; current, not as of the last snapshot)
+  // Preconditions: Both ids are valid
+  // Postconditions: Returns the estimate
+  long Estimate(int from, int to) const;
+  // Name: GetMemoryUsage()
+  // Desc: Bytes held by the count-min sketch of every leg
+  // Preconditions: None
+  // Postconditions: Returns the bytes (fixed at construction)
+  size_t GetMemoryUsage() const;
+  // Name: Clear()
+  // Desc: Waits for any ingestion, then forgets every count
+  // Preconditions: None
+  // Postconditions: GetSnapshot returns an empty, done snapshot
+  void Clear();
+ private:
+  // Name: LegKey(int, int)
+  // Desc: Key of the directed leg from -> to
+  static uint64_t LegKey(int from, int to);
+  // Name: ReadLoop()
+  // Desc: Reader thread: queues chunks of whole lines until end of file
+  void ReadLoop();
+  // Name: AggregateLoop()
+  // Desc: Aggregator thread: parses and merges chunks until none are left
+  void AggregateLoop();
+  // Name: Parse(string&, unordered_map<uint64_t, long>&, long&, long&)
+  // Desc: Counts the legs of a chunk into legs; adds lines and skipped
+  void Parse(const string& chunk, unordered_map<uint64_t, long>& legs,
+             long& lines, long& skipped) const;
+  // Name: Merge(unordered_map<uint64_t, long>&, long, long)
+  // Desc: Adds one chunk's counts to the summaries (takes m_lock)
+  void Merge(const unordered_map<uint64_t, long>& legs, long lines, long skipped);
+  // Name: Publish(bool)
+  // Desc: Publishes a snapshot of the summaries; m_lock must be held
+  void Publish(bool done);
+  // Name: Miles(int, int)
+  // Desc: Miles between two airports
+  double Miles(int from, int to) const;
+  const AirportCatalog& m_catalog; //Codes and coordinates
+  const DistanceCache& m_cache; //Leg miles when built
+  ifstream m_file; //File being ingested
+  thread m_reader; //Runs ReadLoop
+  vector<thread> m_aggregators; //Run AggregateLoop
+  atomic<bool> m_running; //A file is being ingested
+  atomic<bool> m_stopping; //Set by the destructor
+  //Chunk queue (guarded by m_queueLock)
+  mutex m_queueLock;
+  condition_variable m_queued; //A chunk was queued or reading ended
+  condition_variable m_taken; //A chunk was taken off the queue
+  deque<string> m_chunks; //Chunks waiting for an aggregator
+  vector<string> m_spare; //Buffers to reuse for reading
+  int m_queueLimit; //Most chunks in m_chunks
+  bool m_readDone; //The reader has queued its last chunk
+  int m_active; //Aggregators still running
+  //Summaries (guarded by m_lock)
+  mutable mutex m_lock;
+  CountMinSketch m_sketch; //Every leg
+  SpaceSaving m_heavy; //Heaviest legs
+  long m_lines;
+  long m_legs;
+  long m_skipped;
+  double m_miles;
+  int m_sinceSnapshot; //Chunks merged since the last snapshot
+  shared_ptr<const LegSnapshot> m_snapshot; //Read with atomic_load
+};
+
+#endif
@@ -1,16 +1,19 @@
 #include "Navigator.h"
 
+#include <algorithm>
+
 // Constructor that initializes a Navigator object with a file name.
-Navigator::Navigator(string fileName = "proj3_data.txt") {
+Navigator::Navigator(string fileName = "proj3_data.txt")
+    : m_optimizer(m_catalog, m_distances, &m_pool), m_network(&m_pool),
+      m_reach(&m_pool), m_shape(m_catalog), m_legStream(m_catalog, m_distances) {
     m_fileName = fileName; // Assign the provided file name to the member variable.
+    m_log = &cout;
+    m_concurrent = false;
 }
 
 // Destructor that cleans up dynamically allocated memory for airports and routes.
 Navigator::~Navigator() {
-    // Delete all dynamically allocated Airport objects.
-    for (int i = 0; i < static_cast<int>(m_airports.size()); i++) {
-        delete m_airports[i];
-    }
+    // Airports live in m_airportStore and are released with it.
     // Delete all dynamically allocated Route objects.
     for (int i = 0; i < static_cast<int>(m_routes.size()); i++) {
         delete m_routes[i];
@@ -18,8 +21,20 @@ Navigator::~Navigator() {
 }
 
 void Navigator::Start() {
-    ReadFile();
+    Load(true);
     MainMenu();
+    SaveSnapshot();
+}
+
+void Navigator::Load(bool restoreRoutes) {
+    STATS_TIMER(STAT_LOAD);
+    if (!LoadSnapshot(restoreRoutes)) {
+        ReadFile();
+    }
+}
+
+void Navigator::SetLogStream(ostream& log) {
+    m_log = &log;
 }
 
 // Displays all loaded airports to the console.
@@ -37,42 +52,83 @@ void Navigator::DisplayAirports() {
 
 // Reads airport data from a file and populates the airports vector.
 void Navigator::ReadFile() {
-    ifstream inFile(m_fileName);
-    if (!inFile.is_open()) {
+    STATS_TIMER(STAT_READ_FILE);
+    AirportLoader loader;
+    if (!loader.Load(m_fileName, m_catalog)) {
         cerr << "Error opening file " << m_fileName << endl;
         return;
     }
 
-    string line;
-    // Read each line from the file.
-    while (getline(inFile, line)) {
-        vector<string> fields; // Temporary storage for the fields in each line.
-        // Parse the line into comma-separated fields.
-        int start = 0, end;
-        while ((end = static_cast<int>(line.find(',', start))) != -1) {
-            fields.push_back(line.substr(start, end - start));
-            start = end + 1;
-        }
-        // Add the last field after the last comma.
-        fields.push_back(line.substr(start));
-        // If the correct number of fields are found, create a new Airport object.
-        if (fields.size() == 6) {
-            // Parse and store the fields.
-            string code = fields[0];
-            string name = fields[1];
-            string city = fields[2];
-            string country = fields[3];
-            double latitude = stod(fields[4]);
-            double longitude = stod(fields[5]);
-
-            // Add the new Airport to the list.
-            m_airports.push_back(new Airport(code, name, city, country, latitude, longitude));
+    *m_log << "Opened file" << endl;
+    BuildAirports();
+    BuildIndexes();
+    *m_log << "Airports loaded: " << m_airports.size() << endl;
+    MemoryUsage memory = GetMemoryUsage();
+    *m_log << "Memory used: " << (memory.catalog + 1023) / 1024 << " KB airports, "
+           << (memory.distances + 1023) / 1024 << " KB distances" << endl;
+    if (loader.GetErrorCount() > 0) {
+        *m_log << "Rows skipped: " << loader.GetErrorCount() << endl;
+    }
+}
+
+// Creates an Airport for every catalog row and precomputes the indexes.
+void Navigator::BuildAirports() {
+    // One allocation holds every airport (reserved so pointers stay valid)
+    m_airportStore.clear();
+    m_airports.clear();
+    m_airportStore.reserve(m_catalog.GetSize());
+    for (int id = 0; id < m_catalog.GetSize(); id++) {
+        m_airportStore.push_back(Airport(&m_catalog, id));
+        m_airports.push_back(&m_airportStore.back());
+    }
+    m_network.Reset(m_catalog.GetSize());
+    m_reach.Clear();
+}
+
+// Precomputes every leg once so route distances need no trig.
+void Navigator::BuildIndexes() {
+    m_distances.Build(m_catalog);
+    m_spatial.Build(m_catalog);
+}
+
+bool Navigator::LoadSnapshot(bool restoreRoutes) {
+    string fileName = m_fileName + SNAPSHOT_EXTENSION;
+    ifstream probe(fileName.c_str());
+    if (!probe.is_open()) {
+        return false; // No snapshot yet; not an error.
+    }
+    probe.close();
+
+    vector<vector<int> > routes;
+    if (!m_snapshot.Load(fileName, m_fileName, m_catalog, m_distances, m_spatial, routes)) {
+        *m_log << "Snapshot " << fileName << " not used: " << m_snapshot.GetError() << endl;
+        return false;
+    }
+
+    *m_log << "Opened snapshot " << fileName << endl;
+    BuildAirports();
+    for (int i = 0; restoreRoutes && i < static_cast<int>(routes.size()); i++) {
+        Route* route = new Route(&m_airports, &m_distances);
+        for (int j = 0; j < static_cast<int>(routes[i].size()); j++) {
+            route->InsertEnd(routes[i][j]);
         }
+        route->SetName(route->UpdateName());
+        AddRoute(route);
     }
+    *m_log << "Airports loaded: " << m_airports.size() << endl;
+    *m_log << "Routes loaded: " << m_routes.size() << endl;
+    return true;
+}
 
-    inFile.close();
-    cout << "Opened file" << endl;
-    cout << "Airports loaded: " << m_airports.size() << endl;
+void Navigator::SaveSnapshot() {
+    // Nothing worth saving if the airport file could not be read.
+    if (m_catalog.GetSize() == 0) {
+        return;
+    }
+    string fileName = m_fileName + SNAPSHOT_EXTENSION;
+    if (!m_snapshot.Save(fileName, m_fileName, m_catalog, m_distances, m_spatial, m_routes)) {
+        cerr << "Error saving snapshot " << fileName << ": " << m_snapshot.GetError() << endl;
+    }
 }
 
 
@@ -81,19 +137,30 @@ void Navigator::InsertNewRoute() {
     cout << "Select airports for the new route (minimum 2 airports)." << endl;
     DisplayAirports(); // Show available airports to choose from.
 
-    Route* route = new Route(); // Create a new route.
+    Route* route = new Route(&m_airports, &m_distances); // Create a new route of airport ids.
 
     int airportIndex;
+    string entry;
     // Allow the user to select airports until they decide to finish.
     do {
         cout << "Enter the number of the airport to add to your Route: (-1 to end)" << endl;
-        cin >> airportIndex;
+        if (!(cin >> entry)) {
+            airportIndex = -1; // End of input finishes the route.
+        } else {
+            // Accept either a menu number or a three-letter code.
+            char* end = nullptr;
+            long number = strtol(entry.c_str(), &end, 10);
+            if (*end == '\0') {
+                airportIndex = static_cast<int>(number);
+            } else {
+                airportIndex = FindAirport(entry) + 1; // 0 (invalid) if not found
+            }
+        }
         cin.ignore(); // Clear the input buffer to prevent input errors.
 
         // Validate the input and add the selected airport to the route.
         if (airportIndex >= 1 && airportIndex <= (int)m_airports.size()) {
-            Airport* airport = m_airports[airportIndex - 1];
-            route->InsertEnd(airport->GetCode(), airport->GetName(), airport->GetCity(), airport->GetCountry(), airport->GetNorth(), airport->GetWest());
+            route->InsertEnd(airportIndex - 1);
         } else if (airportIndex != -1) {
             cout << "Invalid airport number - Please try again" << endl;
         }
@@ -110,9 +177,237 @@ void Navigator::InsertNewRoute() {
     string routeName = route->UpdateName();
     cout << "Done Building a New Route named " << routeName << endl;
 
-    m_routes.push_back(route); // Add the new route to the list of routes.
+    AddRoute(route); // Add the new route to the list of routes.
+}
+
+
+int Navigator::FindAirport(string_view code) {
+    return m_catalog.FindCode(code);
+}
+
+int Navigator::GetAirportCount() {
+    return static_cast<int>(m_airports.size());
+}
+
+int Navigator::GetRouteCount() {
+    return static_cast<int>(m_routes.size());
+}
+
+Airport* Navigator::GetAirport(int id) {
+    if (id < 0 || id >= static_cast<int>(m_airports.size())) {
+        return nullptr;
+    }
+    return m_airports[id];
+}
+
+Route* Navigator::GetRoute(int index) {
+    if (index < 0 || index >= static_cast<int>(m_routes.size())) {
+        return nullptr;
+    }
+    return m_routes[index];
 }
 
+int Navigator::AddRoute(const vector<int>& ids) {
+    if (static_cast<int>(ids.size()) < ROUTE_MIN) {
+        return -1;
+    }
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+        if (ids[i] < 0 || ids[i] >= static_cast<int>(m_airports.size())) {
+            return -1;
+        }
+    }
+    Route* route = new Route(&m_airports, &m_distances);
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+        route->InsertEnd(ids[i]);
+    }
+    route->SetName(route->UpdateName());
+    return AddRoute(route);
+}
+
+int Navigator::AddRoute(Route* route) {
+    lock_guard<mutex> lock(m_editLock);
+    m_routes.push_back(route);
+    int index = static_cast<int>(m_routes.size()) - 1;
+    vector<int> stops;
+    RouteStops(route, stops);
+    m_routeIndex.AddRoute(index, stops);
+    m_network.AddRoute(stops);
+    PublishRoute(index);
+    return index;
+}
+
+bool Navigator::RemoveStop(int index, int position) {
+    lock_guard<mutex> lock(m_editLock);
+    Route* route = GetRoute(index);
+    if (route == nullptr || position < 0 || position >= route->GetSize() ||
+        route->GetSize() <= ROUTE_MIN) {
+        return false;
+    }
+    vector<int> stops;
+    RouteStops(route, stops);
+    m_routeIndex.RemoveStop(index, stops, position);
+    m_network.RemoveStop(stops, position);
+    route->RemoveAirport(position);
+    PublishRoute(index);
+    return true;
+}
+
+void Navigator::RouteStops(Route* route, vector<int>& stops) {
+    stops.clear();
+    for (int i = 0; i < route->GetSize(); i++) {
+        stops.push_back(route->GetID(i));
+    }
+}
+
+void Navigator::RoutesThrough(const vector<int>& airports, vector<int>& routes) {
+    STATS_TIMER(STAT_INDEX_QUERY);
+    m_routeIndex.RoutesThrough(airports, routes);
+}
+
+bool Navigator::SimilarRoutes(int index, int minShared, vector<int>& routes, vector<int>& shared) {
+    STATS_TIMER(STAT_INDEX_QUERY);
+    routes.clear();
+    shared.clear();
+    Route* route = GetRoute(index);
+    if (route == nullptr) {
+        return false;
+    }
+    vector<int> stops;
+    RouteStops(route, stops);
+    m_routeIndex.RoutesSharingLegs(stops, minShared, index, routes, shared);
+    return true;
+}
+
+bool Navigator::ReverseStops(int index) {
+    lock_guard<mutex> lock(m_editLock);
+    Route* route = GetRoute(index);
+    if (route == nullptr) {
+        return false;
+    }
+    // Legs are directed in m_network (undirected in m_routeIndex)
+    vector<int> stops;
+    RouteStops(route, stops);
+    m_network.RemoveRoute(stops);
+    route->ReverseRoute();
+    reverse(stops.begin(), stops.end());
+    m_network.AddRoute(stops);
+    PublishRoute(index);
+    return true;
+}
+
+void Navigator::HubAirports(int k, vector<int>& ids, vector<double>& scores, vector<int>& degrees) {
+    STATS_TIMER(STAT_NETWORK);
+    m_network.Hubs(k, ids);
+    const vector<double>& betweenness = m_network.Betweenness();
+    scores.clear();
+    degrees.clear();
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+        scores.push_back(betweenness[ids[i]]);
+        degrees.push_back(m_network.GetOutDegree(ids[i]) + m_network.GetInDegree(ids[i]));
+    }
+}
+
+NetworkStats Navigator::GetNetworkStats() {
+    STATS_TIMER(STAT_NETWORK);
+    return m_network.GetStats();
+}
+
+bool Navigator::IngestLegs(const string& fileName, bool wait) {
+    if (!m_legStream.Start(fileName, m_pool.GetThreadCount())) {
+        return false;
+    }
+    if (wait) {
+        m_legStream.Wait();
+    }
+    return true;
+}
+
+shared_ptr<const LegSnapshot> Navigator::GetLegSnapshot() {
+    return m_legStream.GetSnapshot();
+}
+
+long Navigator::EstimateLegCount(int from, int to) {
+    return m_legStream.Estimate(from, to);
+}
+
+void Navigator::EnableConcurrentReads() {
+    lock_guard<mutex> lock(m_editLock);
+    vector<shared_ptr<const RouteView> > views;
+    for (int i = 0; i < static_cast<int>(m_routes.size()); i++) {
+        views.push_back(MakeView(m_routes[i]));
+    }
+    m_published.PublishAll(views);
+    m_concurrent = true;
+}
+
+void Navigator::PublishRoute(int index) {
+    if (m_concurrent) {
+        m_published.Publish(index, MakeView(m_routes[index]));
+    }
+}
+
+shared_ptr<const RouteView> Navigator::MakeView(Route* route) {
+    shared_ptr<RouteView> view = make_shared<RouteView>();
+    RouteStops(route, view->stops);
+    for (int i = 0; i + 1 < route->GetSize(); i++) {
+        view->legs.push_back(route->GetLeg(i));
+    }
+    view->miles = route->GetDistance();
+    view->name = route->UpdateName();
+    return view;
+}
+
+int Navigator::ReadRouteCount() const {
+    ConcurrentRoutes::ReadGuard guard(m_published);
+    return static_cast<int>(guard.Get().routes.size());
+}
+
+bool Navigator::ReadRoute(int index, RouteView& view) const {
+    ConcurrentRoutes::ReadGuard guard(m_published);
+    const RouteSet& routes = guard.Get();
+    if (index < 0 || index >= static_cast<int>(routes.routes.size())) {
+        return false;
+    }
+    view = *routes.routes[index];
+    return true;
+}
+
+double Navigator::ReadRouteMiles(int index) const {
+    ConcurrentRoutes::ReadGuard guard(m_published);
+    const RouteSet& routes = guard.Get();
+    if (index < 0 || index >= static_cast<int>(routes.routes.size())) {
+        return -1;
+    }
+    return routes.routes[index]->miles;
+}
+
+double Navigator::AirportDistance(int from, int to) const {
+    if (m_distances.IsBuilt()) {
+        return m_distances.GetDistance(from, to);
+    }
+    return Haversine(m_catalog.GetNorth(from), m_catalog.GetWest(from),
+                     m_catalog.GetNorth(to), m_catalog.GetWest(to));
+}
+
+MemoryUsage Navigator::GetMemoryUsage() const {
+    MemoryUsage memory;
+    memory.catalog = m_catalog.GetMemoryUsage();
+    memory.distances = m_distances.GetMemoryUsage();
+    memory.routeIndex = m_routeIndex.GetMemoryUsage();
+    memory.reachability = m_reach.GetMemoryUsage();
+    memory.legs = m_legStream.GetMemoryUsage();
+    memory.total = memory.catalog + memory.distances + memory.routeIndex +
+        memory.reachability + memory.legs;
+    return memory;
+}
+
+const AirportCatalog& Navigator::GetCatalog() const {
+    return m_catalog;
+}
+
+const DistanceCache& Navigator::GetDistances() const {
+    return m_distances;
+}
 
 // Displays main menu
 void Navigator::MainMenu() {
@@ -123,7 +418,10 @@ void Navigator::MainMenu() {
              << "2. Display Route\n"
              << "3. Remove Airport From Route\n"
              << "4. Reverse Route\n"
-             << "5. Exit\n";
+             << "5. Exit\n"
+             << "6. Plan Route\n"
+             << "7. Find Nearby Airports\n"
+             << "8. Optimize Route\n";
         cin >> choice;
         switch (choice) {
             case 1:
@@ -144,6 +442,15 @@ void Navigator::MainMenu() {
                 cout << "Deleting Routes" << endl;
                 //~Navigator() desctructor is executed automatically.
                 break;
+            case 6:
+                PlanNewRoute();
+                break;
+            case 7:
+                FindNearbyAirports();
+                break;
+            case 8:
+                OptimizeExistingRoute();
+                break;
             default:
                 cout << "Invalid choice. Please try again." << endl;
         }
@@ -260,7 +567,7 @@ void Navigator::RemoveAirportFromRoute() {
 }
     // Remove the selected airport from the route.
     cout << route->UpdateName() << endl;
-    route->RemoveAirport(airportIndex - 1);
+    RemoveStop(routeIndex, airportIndex - 1);
 
     // Display the updated route after removing the airport.
     for (int i = 0; i < route->GetSize(); ++i) {
@@ -290,23 +597,317 @@ void Navigator::ReverseRoute() {
 
      // Retrieve the pointer to the selected route based on the user's choice.
     Route* route = m_routes[routeIndex];
-    // Reverse the order of airports in the route. Calls the function from Route.cpp
-    route->ReverseRoute();
+    // Reverse the order of airports in the route (and its legs in m_network)
+    ReverseStops(routeIndex);
     // Prints the updated reversed route name
     cout << "Done reversing Route " << route->UpdateName() << endl;
 }
 
 double Navigator::RouteDistance(Route* route) {
-    double totalDistance = 0.0;
+    return route->GetDistance(); // Kept up to date by the route
+}
+
+RouteStats Navigator::MeasureRoute(Route* route) {
+    RouteStats stats = {route->GetDistance(), 0, 0.0, 0.0};
+    int legs = route->GetSize() - 1;
+    if (legs < 1) {
+        return stats;
+    }
+    stats.legs = legs;
+    stats.minLeg = route->GetLeg(0);
+    stats.maxLeg = route->GetLeg(0);
+    for (int i = 1; i < legs; i++) {
+        double leg = route->GetLeg(i);
+        if (leg < stats.minLeg) {
+            stats.minLeg = leg;
+        }
+        if (leg > stats.maxLeg) {
+            stats.maxLeg = leg;
+        }
+    }
+    return stats;
+}
+
+RouteStats Navigator::MeasureRoutes(vector<RouteStats>& stats) {
+    STATS_TIMER(STAT_MEASURE);
+    int count = static_cast<int>(m_routes.size());
+    stats.assign(count, RouteStats());
+
+    // Cut the routes into contiguous chunks of about equal leg count
+    long totalLegs = 0;
+    for (int i = 0; i < count; i++) {
+        totalLegs += m_routes[i]->GetSize();
+    }
+    long target = totalLegs / (m_pool.GetThreadCount() * ROUTE_CHUNKS_PER_THREAD);
+    if (target < ROUTE_CHUNK_MIN_LEGS) {
+        target = ROUTE_CHUNK_MIN_LEGS;
+    }
+    vector<pair<long, pair<int, int> > > chunks; // (legs, [begin, end))
+    long chunkLegs = 0;
+    int begin = 0;
+    for (int i = 0; i < count; i++) {
+        chunkLegs += m_routes[i]->GetSize();
+        if (chunkLegs >= target || i == count - 1) {
+            chunks.push_back(make_pair(chunkLegs, make_pair(begin, i + 1)));
+            chunkLegs = 0;
+            begin = i + 1;
+        }
+    }
+    // Longest first so a big chunk never starts last
+    stable_sort(chunks.begin(), chunks.end(),
+                [](const pair<long, pair<int, int> >& a, const pair<long, pair<int, int> >& b) {
+                    return a.first > b.first;
+                });
+
+    vector<function<void()> > tasks;
+    for (int c = 0; c < static_cast<int>(chunks.size()); c++) {
+        int first = chunks[c].second.first;
+        int last = chunks[c].second.second;
+        tasks.push_back([this, &stats, first, last]() {
+            for (int i = first; i < last; i++) {
+                stats[i] = MeasureRoute(m_routes[i]);
+            }
+        });
+    }
+    m_pool.Run(tasks);
+
+    // Reduce in route order so the totals are reproducible
+    RouteStats totals = {0.0, 0, 0.0, 0.0};
+    bool any = false;
+    for (int i = 0; i < count; i++) {
+        if (stats[i].legs == 0) {
+            continue;
+        }
+        totals.miles += stats[i].miles;
+        totals.legs += stats[i].legs;
+        if (!any || stats[i].minLeg < totals.minLeg) {
+            totals.minLeg = stats[i].minLeg;
+        }
+        if (!any || stats[i].maxLeg > totals.maxLeg) {
+            totals.maxLeg = stats[i].maxLeg;
+        }
+        any = true;
+    }
+    return totals;
+}
+
+void Navigator::UsePlanner(double maxLeg) {
+    // Edges depend on the range, so only rebuild when it changes.
+    if (!m_planner.IsBuilt() || m_planner.GetMaxLeg() != maxLeg) {
+        m_planner.Build(m_catalog, maxLeg, m_distances, m_spatial);
+    }
+}
+
+Route* Navigator::PathToRoute(const vector<int>& path) {
+    Route* route = new Route(&m_airports, &m_distances);
+    for (int i = 0; i < static_cast<int>(path.size()); i++) {
+        route->InsertEnd(path[i]);
+    }
+    route->SetName(route->UpdateName());
+    return route;
+}
+
+Route* Navigator::PlanRoute(int startID, int goalID, double maxLeg) {
+    STATS_TIMER(STAT_PLAN);
+    if (startID == goalID) {
+        return nullptr; // A route needs at least ROUTE_MIN airports
+    }
+    UsePlanner(maxLeg);
+    vector<int> path;
+    if (m_planner.Plan(startID, goalID, path) < 0) {
+        return nullptr;
+    }
+    return PathToRoute(path);
+}
+
+int Navigator::ParetoRoutes(int startID, int goalID, double maxLeg, int maxHops,
+                            vector<Route*>& routes) {
+    STATS_TIMER(STAT_PARETO);
+    routes.clear();
+    if (startID == goalID) {
+        return 0; // A route needs at least ROUTE_MIN airports
+    }
+    UsePlanner(maxLeg);
+    vector<ParetoPath> frontier;
+    m_planner.Pareto(startID, goalID, maxHops, frontier);
+    for (int i = 0; i < static_cast<int>(frontier.size()); i++) {
+        routes.push_back(PathToRoute(frontier[i].path));
+    }
+    return static_cast<int>(routes.size());
+}
+
+bool Navigator::Reachable(int startID, int goalID, double maxLeg, int maxHops, int& hops) {
+    STATS_TIMER(STAT_REACH);
+    const ReachabilityIndex& reach = m_reach.Get(m_catalog, m_spatial, maxLeg);
+    hops = reach.MinHops(startID, goalID);
+    return hops >= 0 && (maxHops <= 0 || hops <= maxHops);
+}
+
+long Navigator::CountRoutePoints(int index, const ShapeSpacing& spacing) {
+    if (index < 0 || index >= static_cast<int>(m_routes.size())) {
+        return -1;
+    }
+    vector<int> stops;
+    RouteStops(m_routes[index], stops);
+    return m_shape.CountPoints(stops, spacing);
+}
+
+bool Navigator::AppendRouteShape(int index, const ShapeSpacing& spacing, bool polyline, string& text) {
+    if (index < 0 || index >= static_cast<int>(m_routes.size())) {
+        return false;
+    }
+    vector<int> stops;
+    RouteStops(m_routes[index], stops);
+    if (polyline) {
+        m_shape.AppendPolyline(stops, spacing, text);
+    } else {
+        m_shape.AppendGeoJSON(stops, spacing, m_routes[index]->GetName(), text);
+    }
+    return true;
+}
+
+void Navigator::PlanNewRoute() {
+    if (m_airports.size() < 2) {
+        cout << "Not enough airports to plan a route." << endl;
+        return;
+    }
+    DisplayAirports(); // Show available airports to choose from.
+
+    int startIndex;
+    int goalIndex;
+    double maxLeg;
+    int size = static_cast<int>(m_airports.size());
+    cout << "Enter the number of the starting airport:" << endl;
+    while (!(cin >> startIndex) || startIndex < 1 || startIndex > size) {
+        cin.clear(); // Clear error state
+        cin.ignore(); // Clear input buffer
+        cout << "Invalid airport number - Please try again" << endl;
+    }
+    cout << "Enter the number of the destination airport:" << endl;
+    while (!(cin >> goalIndex) || goalIndex < 1 || goalIndex > size || goalIndex == startIndex) {
+        cin.clear(); // Clear error state
+        cin.ignore(); // Clear input buffer
+        cout << "Invalid airport number - Please try again" << endl;
+    }
+    cout << "Enter the maximum miles of a single leg: (0 for no limit)" << endl;
+    while (!(cin >> maxLeg) || maxLeg < 0) {
+        cin.clear(); // Clear error state
+        cin.ignore(); // Clear input buffer
+        cout << "Invalid range - Please try again" << endl;
+    }
+
+    Route* route = PlanRoute(startIndex - 1, goalIndex - 1, maxLeg);
+    if (route == nullptr) {
+        cout << "No route found within a " << maxLeg << " mile range" << endl;
+        return;
+    }
+
+    // Display the planned route and its total distance.
+    cout << route->UpdateName() << endl;
+    for (int i = 0; i < route->GetSize(); ++i) {
+        Airport* airport = route->GetData(i);
+        cout << i + 1 << ". " << airport->GetCode() << ", " << airport->GetName() << ", " << airport->GetCity() << ", " << airport->GetCountry() << " (" << "N" << airport->GetNorth() << " W" << airport->GetWest() << ")" << endl;
+    }
+    cout << "The total miles of this route is " << RouteDistance(route) << " miles" << endl;
 
-    // Iterate through each airport in the route, except the last one
-    for (int i = 0; i < route->GetSize() - 1; i++) {
-        Airport* currentAirport = route->GetData(i); // Get the current airport
-        Airport* nextAirport = route->GetData(i + 1); // Get the next airport
+    AddRoute(route); // Add the new route to the list of routes.
+}
+
+bool Navigator::OptimizeRoute(int index, bool fixEnd, double budgetMs, OptimizeStats& stats) {
+    STATS_TIMER(STAT_OPTIMIZE);
+    lock_guard<mutex> lock(m_editLock);
+    Route* route = GetRoute(index);
+    if (route == nullptr) {
+        return false;
+    }
+    vector<int> ids;
+    RouteStops(route, ids);
+    m_routeIndex.RemoveRoute(index, ids);
+    m_network.RemoveRoute(ids);
+    stats = m_optimizer.Optimize(ids, fixEnd, budgetMs);
+    m_routeIndex.AddRoute(index, ids);
+    m_network.AddRoute(ids);
+
+    // Rebuild so the legs and name match the new order
+    Route* optimized = new Route(&m_airports, &m_distances);
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+        optimized->InsertEnd(ids[i]);
+    }
+    optimized->SetName(optimized->UpdateName());
+    delete route;
+    m_routes[index] = optimized;
+    PublishRoute(index);
+    return true;
+}
+
+void Navigator::OptimizeExistingRoute() {
+    if (m_routes.size() == 0) {
+        cout << "No routes to optimize" << endl;
+        return;
+    }
+    int routeIndex = ChooseRoute();
+    if (routeIndex == -1) {
+        return;
+    }
+
+    string answer;
+    cout << "Keep the last airport last? (y/n)" << endl;
+    cin >> answer;
+    bool fixEnd = answer.size() > 0 && (answer[0] == 'y' || answer[0] == 'Y');
+
+    OptimizeStats stats;
+    OptimizeRoute(routeIndex, fixEnd, OPT_BUDGET_MS, stats);
+    Route* route = m_routes[routeIndex];
+    cout << route->UpdateName() << endl;
+    for (int i = 0; i < route->GetSize(); ++i) {
+        Airport* airport = route->GetData(i);
+        cout << i + 1 << ". " << airport->GetCode() << ", " << airport->GetName() << ", " << airport->GetCity() << ", " << airport->GetCountry() << " (" << "N" << airport->GetNorth() << " W" << airport->GetWest() << ")" << endl;
+    }
+    cout << "The total miles of this route went from " << stats.before << " to " << stats.after << " miles" << endl;
+    if (!stats.finished) {
+        cout << "Stopped early: time limit reached" << endl;
+    }
+}
+
+void Navigator::NearestAirports(int id, int k, vector<int>& ids, vector<double>& miles) {
+    STATS_TIMER(STAT_NEAREST);
+    Airport* airport = m_airports[id];
+    m_spatial.Nearest(airport->GetNorth(), airport->GetWest(), k, ids, miles, id);
+}
+
+void Navigator::AirportsWithin(double north, double west, double radius,
+                               vector<int>& ids, vector<double>& miles) {
+    m_spatial.Within(north, west, radius, ids, miles);
+}
+
+void Navigator::FindNearbyAirports() {
+    if (m_airports.size() < 2) {
+        cout << "Not enough airports to search." << endl;
+        return;
+    }
+    DisplayAirports(); // Show available airports to choose from.
+
+    int airportIndex;
+    int count;
+    int size = static_cast<int>(m_airports.size());
+    cout << "Enter the number of the airport to search from:" << endl;
+    while (!(cin >> airportIndex) || airportIndex < 1 || airportIndex > size) {
+        cin.clear(); // Clear error state
+        cin.ignore(); // Clear input buffer
+        cout << "Invalid airport number - Please try again" << endl;
+    }
+    cout << "How many nearby airports would you like to see?" << endl;
+    while (!(cin >> count) || count < 1) {
+        cin.clear(); // Clear error state
+        cin.ignore(); // Clear input buffer
+        cout << "Invalid number - Please try again" << endl;
+    }
 
-        // Calculate the distance between the current and next airports. Calls the function from Navigator.h
-        totalDistance += CalcDistance(currentAirport->GetNorth(), currentAirport->GetWest(),
-                                       nextAirport->GetNorth(), nextAirport->GetWest());
+    vector<int> ids;
+    vector<double> miles;
+    NearestAirports(airportIndex - 1, count, ids, miles);
+    cout << "Airports nearest to " << *m_airports[airportIndex - 1] << endl;
+    for (int i = 0; i < static_cast<int>(ids.size()); i++) {
+        cout << i + 1 << ". " << *m_airports[ids[i]] << " (" << miles[i] << " miles)" << endl;
     }
-    return totalDistance; // Returns total distance
 }
@@ -7,22 +7,54 @@
 #define NAVIGATOR_H
 
 #include "Airport.h"
+#include "AirportCatalog.h"
 #include "Route.h"
+#include "AirportLoader.h"
+#include "DistanceCache.h"
+#include "Haversine.h"
+#include "SpatialIndex.h"
+#include "RoutePlanner.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include "RouteOptimizer.h"
+#include "RouteIndex.h"
+#include "RouteNetwork.h"
+#include "LegStream.h"
+#include "ConcurrentRoutes.h"
+#include "Reachability.h"
+#include "RouteShape.h"
+#include "Stats.h"
 
 #include <fstream>
 #include <string>
 #include <iostream>
 #include <cstdlib>
 #include <vector>
+#include <mutex>
 using namespace std;
 
-//Constants used for calculating distance
-#define PI 3.14159265358979323846
-#define EARTH_RADIUS 3958.8 //in miles
-#define DEG_2_RAD PI / 180
-#define RAD_2_DEG 180 / PI
-//Constants
+//Constants (distance constants are in Haversine.h)
 const int ROUTE_MIN = 2; //Minimum number of airports in a route
+const int ROUTE_CHUNKS_PER_THREAD = 8; //Work units per thread in MeasureRoutes
+const long ROUTE_CHUNK_MIN_LEGS = 4096; //Smallest work unit in MeasureRoutes
+
+//Measurements of one route (or, as totals, of many)
+struct RouteStats {
+  double miles; //Total miles
+  long legs; //Number of legs
+  double minLeg; //Shortest leg in miles (0 if no legs)
+  double maxLeg; //Longest leg in miles (0 if no legs)
+};
+
+//Bytes held by each of the Navigator's stores
+struct MemoryUsage {
+  size_t catalog; //Airport columns and interned text
+  size_t distances; //Distance cache matrix
+  size_t routeIndex; //Routes by airport and by leg
+  size_t reachability; //Cached reachability indexes
+  size_t legs; //Sketch of ingested flight legs
+  size_t total; //Sum of the above
+};
 
 class Navigator {
  public:
@@ -37,10 +69,22 @@ class Navigator {
   // Postconditions: All airports and routes are cleared
   ~Navigator();
   // Name: Start
-  // Desc: Loads the file and calls the main menu
+  // Desc: Loads the snapshot (or the file if there is no usable
+  //   snapshot), calls the main menu, then saves the snapshot
   // Preconditions: m_fileName is populated
   // Postconditions: All ports are loaded and the main menu runs
   void Start();
+  // Name: Load(bool)
+  // Desc: Loads the snapshot, or the file if there is no usable snapshot.
+  //   Routes saved in the snapshot are only recreated if restoreRoutes.
+  // Preconditions: m_fileName is populated
+  // Postconditions: m_airports and the indexes are ready
+  void Load(bool restoreRoutes);
+  // Name: SetLogStream(ostream&)
+  // Desc: Changes where load progress ("Opened file" etc.) is written
+  // Preconditions: log outlives the Navigator
+  // Postconditions: Sets m_log
+  void SetLogStream(ostream& log);
   // Name: DisplayAirports
   // Desc: Displays each airport in m_airports
   // Preconditions: At least one airport is in m_airports
@@ -50,16 +94,168 @@ class Navigator {
   // Name: ReadFile
   // Desc: Reads in a file that has data about each airport
   //   including code, name, city, country, degrees north and degrees west.
-  //   Dynamically allocates airports and stores them in m_airports
-  //   The vector can hold many airports.
+  //   Parsed by AirportLoader into m_catalog; malformed rows are
+  //   reported with their line number and skipped.
+  //   Calls BuildAirports once loaded.
   // Preconditions: Valid file name of airports
-  // Postconditions: Dynamically allocates each airport
-  //   and enters it into m_airports
+  // Postconditions: m_catalog and m_airports hold every valid airport
   void ReadFile();
+  // Name: LoadSnapshot
+  // Desc: Maps m_fileName + SNAPSHOT_EXTENSION and attaches m_catalog,
+  //   m_distances and m_spatial to it, then recreates the saved routes.
+  //   Nothing is parsed or rebuilt. Fails if the snapshot is missing,
+  //   corrupt, from another version or older than m_fileName.
+  //   Saved routes are only recreated if restoreRoutes.
+  // Preconditions: Nothing loaded yet
+  // Postconditions: Returns true if airports and routes were loaded
+  bool LoadSnapshot(bool restoreRoutes);
+  // Name: SaveSnapshot
+  // Desc: Writes the catalog, indexes and routes to
+  //   m_fileName + SNAPSHOT_EXTENSION for the next start
+  // Preconditions: None
+  // Postconditions: Reports an error if the snapshot could not be written
+  void SaveSnapshot();
+  // Name: FindAirport(string_view)
+  // Desc: Finds an airport by its code using m_catalog's code index
+  //   (no scan of m_airports)
+  // Preconditions: None
+  // Postconditions: Returns the airport's index in m_airports, or -1
+  int FindAirport(string_view code);
+  // Name: GetAirportCount / GetRouteCount
+  // Preconditions: None
+  // Postconditions: Returns the size of m_airports / m_routes
+  int GetAirportCount();
+  int GetRouteCount();
+  // Name: GetAirport(int)
+  // Preconditions: None
+  // Postconditions: Returns the airport at id in m_airports, or nullptr
+  Airport* GetAirport(int id);
+  // Name: GetRoute(int)
+  // Preconditions: None
+  // Postconditions: Returns the route at index in m_routes, or nullptr
+  Route* GetRoute(int index);
+  // Name: AddRoute(vector<int>&)
+  // Desc: Builds a route through the given airport ids without prompting
+  //   and inserts it into m_routes. Named using Route's UpdateName.
+  // Preconditions: None
+  // Postconditions: Returns the new route's index, or -1 if there are
+  //   fewer than ROUTE_MIN airports or an id is not in m_airports
+  int AddRoute(const vector<int>& ids);
+  // Name: AddRoute(Route*)
+  // Desc: Inserts a route (for example from PlanRoute) into m_routes,
+  //   which takes ownership of it, and adds it to m_routeIndex and m_network
+  // Preconditions: route was allocated with new
+  // Postconditions: Returns the route's index in m_routes
+  int AddRoute(Route* route);
+  // Name: RemoveStop(int, int)
+  // Desc: Removes the airport at position from route index in m_routes
+  //   and updates m_routeIndex and m_network for just that airport and its legs
+  // Preconditions: None
+  // Postconditions: Returns false (and changes nothing) if either index
+  //   is invalid or the route has only ROUTE_MIN airports
+  bool RemoveStop(int index, int position);
+  // Name: RoutesThrough(vector<int>&, vector<int>&)
+  // Desc: Routes that pass through every given airport, found by
+  //   intersecting m_routeIndex's posting lists (no route is scanned)
+  // Preconditions: None
+  // Postconditions: routes holds indexes into m_routes in increasing order
+  void RoutesThrough(const vector<int>& airports, vector<int>& routes);
+  // Name: SimilarRoutes(int, int, vector<int>&, vector<int>&)
+  // Desc: Other routes sharing at least minShared legs with route index
+  //   (a leg is the same in either direction) using m_routeIndex
+  // Preconditions: None
+  // Postconditions: Returns false (and no routes) if index is invalid;
+  //   otherwise routes holds indexes into m_routes in increasing
+  //   order and shared the number of legs each has in common
+  bool SimilarRoutes(int index, int minShared, vector<int>& routes, vector<int>& shared);
+  // Name: ReverseStops(int)
+  // Desc: Reverses route index in m_routes and its legs in m_network
+  // Preconditions: None
+  // Postconditions: Returns false if index is invalid
+  bool ReverseStops(int index);
+  // Name: HubAirports(int, vector<int>&, vector<double>&, vector<int>&)
+  // Desc: The k airports with the highest betweenness in m_network (how
+  //   many fewest-leg connections between other airports pass through
+  //   them), with each one's score and degree (distinct airports flown
+  //   to plus distinct airports flown from)
+  // Preconditions: k >= 0
+  // Postconditions: ids, scores and degrees hold one entry per hub
+  void HubAirports(int k, vector<int>& ids, vector<double>& scores, vector<int>& degrees);
+  // Name: GetNetworkStats()
+  // Preconditions: None
+  // Postconditions: Returns the edge and component counts of m_network
+  NetworkStats GetNetworkStats();
+  // Name: IngestLegs(string&, bool)
+  // Desc: Starts adding a flight-leg log (one "ORIGIN DESTINATION" per
+  //   line) to m_legStream on its own threads; waits for it if wait
+  // Preconditions: None
+  // Postconditions: Returns false if the file cannot be opened
+  bool IngestLegs(const string& fileName, bool wait);
+  // Name: GetLegSnapshot()
+  // Desc: Totals and heaviest legs as of the last snapshot of
+  //   m_legStream (can be called while a log is being ingested)
+  // Preconditions: None
+  // Postconditions: Returns the snapshot
+  shared_ptr<const LegSnapshot> GetLegSnapshot();
+  // Name: EstimateLegCount(int, int)
+  // Desc: Times the leg from -> to appeared in the logs (count-min
+  //   estimate: never below the truth)
+  // Preconditions: Both ids are valid
+  // Postconditions: Returns the estimate
+  long EstimateLegCount(int from, int to);
+  // Name: EnableConcurrentReads()
+  // Desc: Starts publishing every route edit to m_published so the
+  //   Read methods below can run on other threads while routes change.
+  //   Route edits (AddRoute, RemoveStop, ReverseStops, OptimizeRoute)
+  //   are serialized by m_editLock; each then publishes only the route
+  //   it changed. m_catalog, m_airports and the distance indexes are not
+  //   changed after Load, so readers use them without locks.
+  // Preconditions: Airports are loaded
+  // Postconditions: Every existing route is published
+  void EnableConcurrentReads();
+  // Name: ReadRouteCount()
+  // Desc: Thread-safe once EnableConcurrentReads has been called
+  // Preconditions: None
+  // Postconditions: Returns the number of published routes
+  int ReadRouteCount() const;
+  // Name: ReadRoute(int, RouteView&)
+  // Desc: Copies the published route index (thread-safe, never blocks
+  //   on an edit; sees the route either before or after it)
+  // Preconditions: None
+  // Postconditions: Returns false if there is no published route index
+  bool ReadRoute(int index, RouteView& view) const;
+  // Name: ReadRouteMiles(int)
+  // Desc: Miles of the published route index (thread-safe)
+  // Preconditions: None
+  // Postconditions: Returns the miles, or -1 if there is no such route
+  double ReadRouteMiles(int index) const;
+  // Name: AirportDistance(int, int)
+  // Desc: Miles between two airports from the catalog (thread-safe)
+  // Preconditions: Both ids are valid
+  // Postconditions: Returns the miles
+  double AirportDistance(int from, int to) const;
+  // Name: GetCatalog()
+  // Desc: The airport columns, immutable after Load
+  // Preconditions: Airports are loaded
+  // Postconditions: Returns m_catalog
+  const AirportCatalog& GetCatalog() const;
+  // Name: GetDistances()
+  // Desc: The precomputed distances, immutable after Load
+  // Preconditions: Airports are loaded
+  // Postconditions: Returns m_distances
+  const DistanceCache& GetDistances() const;
+  // Name: GetMemoryUsage()
+  // Desc: Bytes allocated by the catalog, distance cache, route index,
+  //   reachability indexes and leg sketch (mapped snapshot data is not
+  //   counted)
+  // Preconditions: None
+  // Postconditions: Returns the usage of each and their total
+  MemoryUsage GetMemoryUsage() const;
   // Name: InsertNewRoute
   // Desc: Dynamically allocates a new route with the user selecting
   //   each airport in the route. Each route can have a minimum of two
   //   airports. Will not allow a one airport route.
+  //   Airports are entered by number or by code (found with FindAirport).
   //   Checks for min of two valid airports (1-40)
   //   Route named using Route's UpdateName.
   //   For example, Baltimore to Boston
@@ -102,14 +298,30 @@ class Navigator {
   //    and new name
   void RemoveAirportFromRoute();
   // Name: RouteDistance
-  // Desc: Calculates the total distance of a route
+  // Desc: Returns the total distance of a route
   //    Goes from airport 1 to airport 2 then airport 2 to airport 3
   //    and repeats for length of route.
-  //    Calculates the distance using CalcDistance (provided)
-  //    Aggregates the total and returns the total in miles
+  //    The route keeps its legs (from m_distances when cached) and their
+  //    total as it is edited, so this is O(1)
   // Preconditions: Populated route with more than one airport
   // Postconditions: Returns the total miles between all airports in a route
   double RouteDistance(Route*);
+  // Name: MeasureRoute(Route*)
+  // Desc: Total miles, leg count and shortest and longest leg of a route.
+  //    Reads the route's stored legs (no distances are computed).
+  //    Only reads the route, so routes can be measured in parallel.
+  // Preconditions: None
+  // Postconditions: Returns the route's stats
+  RouteStats MeasureRoute(Route* route);
+  // Name: MeasureRoutes(vector<RouteStats>&)
+  // Desc: Measures every route in m_routes in parallel on m_pool.
+  //    Routes are cut into contiguous chunks of about equal leg count,
+  //    so a few very long routes do not leave threads idle, and the
+  //    chunks run longest first. Totals are added in route order after
+  //    all chunks finish, so they do not depend on the thread count.
+  // Preconditions: No route is modified while measuring
+  // Postconditions: stats[i] holds route i's stats; returns the totals
+  RouteStats MeasureRoutes(vector<RouteStats>& stats);
   // Name: ReverseRoute
   // Desc: Using ChooseRoute, users chooses route and the route is reversed
   //   If no routes in m_routes, indicates no routes available to reverse
@@ -119,6 +331,94 @@ class Navigator {
   // Postconditions: Reverses a specific route by reversing the airports
   //   in place. Must move airports, cannot just change data in airports.
   void ReverseRoute();
+  // Name: PlanRoute(int, int, double)
+  // Desc: Finds the shortest route from one airport to another where
+  //   no leg is longer than maxLeg miles (0 for unlimited range) using
+  //   m_planner. The planner is rebuilt only when the range changes.
+  //   Route named using Route's UpdateName.
+  // Preconditions: Both airport ids are valid indexes into m_airports
+  // Postconditions: Returns a new dynamically allocated route
+  //   (not inserted into m_routes) or nullptr if no route is in range
+  //   or both airports are the same
+  Route* PlanRoute(int startID, int goalID, double maxLeg);
+  // Name: ParetoRoutes(int, int, double, int, vector<Route*>&)
+  // Desc: Finds the routes from one airport to another that trade miles
+  //   against legs (no leg longer than maxLeg, at most maxHops legs):
+  //   each is the shortest route with its number of legs and shorter
+  //   than every route with fewer. Uses m_planner's Pareto search.
+  //   Each route is named using UpdateName; its RouteDistance is the
+  //   route's total.
+  // Preconditions: Both airport ids are valid indexes into m_airports
+  // Postconditions: routes holds new dynamically allocated routes (not
+  //   inserted into m_routes) in increasing legs and decreasing miles;
+  //   the caller owns them. Returns how many (0 if none in range or
+  //   both airports are the same).
+  int ParetoRoutes(int startID, int goalID, double maxLeg, int maxHops,
+                   vector<Route*>& routes);
+  // Name: Reachable(int, int, double, int, int&)
+  // Desc: Whether goal can be reached from start in at most maxHops legs
+  //   (0 for any number) of at most maxLeg miles (0 for unlimited range),
+  //   and the fewest legs it takes. Uses m_reach, which keeps an index
+  //   per range bucket, so repeated ranges answer in O(1).
+  // Preconditions: Both airport ids are valid indexes into m_airports
+  // Postconditions: hops holds the fewest legs (-1 if never reachable)
+  bool Reachable(int startID, int goalID, double maxLeg, int maxHops, int& hops);
+  // Name: CountRoutePoints(int, ShapeSpacing&)
+  // Desc: Points in route index in m_routes once densified with spacing,
+  //   so a caller can refuse a shape too large to answer
+  // Preconditions: None
+  // Postconditions: Returns the count (-1 if index is invalid)
+  long CountRoutePoints(int index, const ShapeSpacing& spacing);
+  // Name: AppendRouteShape(int, ShapeSpacing&, bool, string&)
+  // Desc: Appends route index in m_routes with each leg densified along
+  //   its great circle by m_shape, as a GeoJSON Feature or (if polyline)
+  //   an encoded polyline
+  // Preconditions: None
+  // Postconditions: Returns false (appending nothing) if index is invalid
+  bool AppendRouteShape(int index, const ShapeSpacing& spacing, bool polyline, string& text);
+  // Name: PlanNewRoute
+  // Desc: User selects a starting airport, a destination and the
+  //   maximum leg length. Uses PlanRoute to build the shortest route.
+  //   Once planned, the route is displayed and inserted into m_routes.
+  //   If the destination is out of range, indicates no route was found.
+  // Preconditions: Populated m_airports
+  // Postconditions: Inserts the planned route into m_routes
+  void PlanNewRoute();
+  // Name: OptimizeRoute(int, bool, double, OptimizeStats&)
+  // Desc: Reorders the stops of route index in m_routes to shorten it
+  //   using m_optimizer. The first stop stays first, and the last stays
+  //   last if fixEnd. Gives up improving after budgetMs milliseconds.
+  //   The route is rebuilt and renamed using UpdateName.
+  // Preconditions: None
+  // Postconditions: Returns false if index is invalid; otherwise stats
+  //   holds the miles before and after
+  bool OptimizeRoute(int index, bool fixEnd, double budgetMs, OptimizeStats& stats);
+  // Name: OptimizeExistingRoute
+  // Desc: Using ChooseRoute, user selects a route and whether the last
+  //   stop must stay last. Uses OptimizeRoute (budget OPT_BUDGET_MS) and
+  //   displays the new order and the miles saved.
+  // Preconditions: Populated m_routes
+  // Postconditions: The chosen route's stops are reordered
+  void OptimizeExistingRoute();
+  // Name: NearestAirports(int, int, vector<int>&, vector<double>&)
+  // Desc: Finds the k airports closest to an airport using m_spatial
+  // Preconditions: id is a valid index into m_airports
+  // Postconditions: ids and miles hold up to k airports (not including
+  //   the airport itself) sorted by distance
+  void NearestAirports(int id, int k, vector<int>& ids, vector<double>& miles);
+  // Name: AirportsWithin(double, double, double, vector<int>&, vector<double>&)
+  // Desc: Finds every airport within radius miles of a point using m_spatial
+  // Preconditions: Coordinates in degrees
+  // Postconditions: ids and miles hold the matches sorted by id
+  void AirportsWithin(double north, double west, double radius,
+                      vector<int>& ids, vector<double>& miles);
+  // Name: FindNearbyAirports
+  // Desc: User selects an airport and how many neighbours to show.
+  //   Displays a numbered list of the nearest airports and their miles
+  //   using NearestAirports.
+  // Preconditions: Populated m_airports
+  // Postconditions: Displays the nearest airports
+  void FindNearbyAirports();
   // Name:  CalcDistance (provided - DO NOT EDIT)
   // Desc: Calculates the distance between two airports by using
   //  their coordinates
@@ -142,9 +442,63 @@ class Navigator {
     return double(EARTH_RADIUS) * c;
   }
 private:
+  // Name: RouteStops(Route*, vector<int>&)
+  // Desc: Fills stops with the airport ids of a route in order
+  // Preconditions: None
+  // Postconditions: stops has one id per airport in the route
+  void RouteStops(Route* route, vector<int>& stops);
+  // Name: UsePlanner(double)
+  // Desc: Rebuilds m_planner if it was built for another range
+  // Preconditions: m_distances and m_spatial are built
+  // Postconditions: m_planner's edges are for maxLeg
+  void UsePlanner(double maxLeg);
+  // Name: PathToRoute(vector<int>&)
+  // Desc: Builds a named route through airport ids in order
+  // Preconditions: Every id is valid
+  // Postconditions: Returns a new dynamically allocated route
+  Route* PathToRoute(const vector<int>& path);
+  // Name: PublishRoute(int)
+  // Desc: Publishes route index to m_published if concurrent reads are on
+  // Preconditions: m_editLock is held
+  // Postconditions: Readers see the route as it is now
+  void PublishRoute(int index);
+  // Name: MakeView(Route*)
+  // Desc: Immutable copy of a route's stops, legs, miles and name
+  // Preconditions: None
+  // Postconditions: Returns the copy
+  shared_ptr<const RouteView> MakeView(Route* route);
+  // Name: BuildAirports
+  // Desc: Allocates every airport in m_catalog in one block
+  //   (m_airportStore) and enters each into m_airports. Each airport is
+  //   a catalog-backed Airport for that row.
+  // Preconditions: m_catalog is populated
+  // Postconditions: m_airports is ready
+  void BuildAirports();
+  // Name: BuildIndexes
+  // Desc: Builds m_distances for all airport pairs and the m_spatial index
+  // Preconditions: m_catalog is populated
+  // Postconditions: m_distances and m_spatial are ready
+  void BuildIndexes();
+  Snapshot m_snapshot; //Mapped snapshot (outlives everything attached to it)
+  AirportCatalog m_catalog; //Columns and interned text of all airports
+  vector<Airport> m_airportStore; //Single allocation for all airports
   vector<Airport*> m_airports; //Vector of all airports
   vector<Route*> m_routes; //Vector of all routes
   string m_fileName; //File to read in
+  DistanceCache m_distances; //Precomputed distances between all airports
+  SpatialIndex m_spatial; //k-d tree for nearest and radius queries
+  RoutePlanner m_planner; //Shortest-path planner for the last range used
+  ostream *m_log; //Where load progress is written (cout by default)
+  ThreadPool m_pool; //Threads for bulk route work
+  RouteOptimizer m_optimizer; //Stop reordering for OptimizeRoute
+  RouteIndex m_routeIndex; //Routes by airport and by leg
+  RouteNetwork m_network; //Union of all routes as a directed graph
+  ReachabilityCache m_reach; //Reachability indexes for recent ranges
+  RouteShape m_shape; //Great-circle geometry of routes for maps
+  LegStream m_legStream; //Summaries of ingested flight-leg logs
+  ConcurrentRoutes m_published; //Routes for readers on other threads
+  bool m_concurrent; //Route edits are published to m_published
+  mutex m_editLock; //Serializes route edits
 };
 
 #endif
@@ -0,0 +1,400 @@
+#include "Reachability.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+ReachabilityIndex::ReachabilityIndex() {
+    m_built = false;
+    m_unlimited = false;
+    m_low = 0.0;
+    m_high = 0.0;
+    m_bucket = -1;
+    m_hopLimit = 0;
+    m_pool = nullptr;
+}
+
+long ReachabilityIndex::Bucket(double maxLeg) {
+    return maxLeg <= 0 ? -1 : static_cast<long>(floor(maxLeg / REACH_BUCKET_MILES));
+}
+
+int ReachabilityIndex::Find(vector<int>& parents, int v) {
+    while (parents[v] != v) {
+        parents[v] = parents[parents[v]];
+        v = parents[v];
+    }
+    return v;
+}
+
+void ReachabilityIndex::Run(vector<function<void()> >& tasks) {
+    if (m_pool == nullptr || m_pool->GetThreadCount() == 1 || tasks.size() == 1) {
+        for (int i = 0; i < static_cast<int>(tasks.size()); i++) {
+            tasks[i]();
+        }
+    } else {
+        m_pool->Run(tasks);
+    }
+}
+
+void ReachabilityIndex::Build(const AirportCatalog& catalog, const SpatialIndex& index,
+                              double maxLeg, ThreadPool* pool) {
+    int size = catalog.GetSize();
+    m_pool = pool;
+    m_unlimited = maxLeg <= 0;
+    m_bucket = Bucket(maxLeg);
+    m_offsets.assign(size + 1, 0);
+    m_targets.clear();
+    m_components.clear();
+    m_first.clear();
+    m_members.clear();
+    m_built = true;
+    if (m_unlimited) {
+        // One component; every pair is one leg apart
+        m_component.assign(size, 0);
+        m_hopLimit = 1;
+        return;
+    }
+
+    // Neighbours of each airport, in parallel. Pairs up to the end of the
+    // bucket are looked at so the range interval the edges hold for is known.
+    double bucketTop = (m_bucket + 1) * REACH_BUCKET_MILES;
+    int threads = m_pool == nullptr ? 1 : m_pool->GetThreadCount();
+    int taskCount = threads * REACH_TASKS_PER_THREAD;
+    if (taskCount > size) {
+        taskCount = size > 0 ? size : 1;
+    }
+    vector<vector<int> > neighbours(size);
+    vector<double> lows(taskCount, 0.0);
+    vector<double> highs(taskCount, numeric_limits<double>::infinity());
+    vector<function<void()> > tasks;
+    for (int t = 0; t < taskCount; t++) {
+        tasks.push_back([&, t]() {
+            vector<int> ids;
+            vector<double> miles;
+            for (int i = static_cast<long>(size) * t / taskCount;
+                 i < static_cast<long>(size) * (t + 1) / taskCount; i++) {
+                index.Within(catalog.GetNorth(i), catalog.GetWest(i), bucketTop, ids, miles);
+                for (int j = 0; j < static_cast<int>(ids.size()); j++) {
+                    if (ids[j] == i) {
+                        continue;
+                    }
+                    if (miles[j] <= maxLeg) {
+                        neighbours[i].push_back(ids[j]);
+                        if (miles[j] > lows[t]) {
+                            lows[t] = miles[j];
+                        }
+                    } else if (miles[j] < highs[t]) {
+                        highs[t] = miles[j];
+                    }
+                }
+            }
+        });
+    }
+    Run(tasks);
+    m_low = 0.0;
+    m_high = numeric_limits<double>::infinity();
+    for (int t = 0; t < taskCount; t++) {
+        m_low = lows[t] > m_low ? lows[t] : m_low;
+        m_high = highs[t] < m_high ? highs[t] : m_high;
+    }
+    for (int i = 0; i < size; i++) {
+        m_targets.insert(m_targets.end(), neighbours[i].begin(), neighbours[i].end());
+        m_offsets[i + 1] = static_cast<int>(m_targets.size());
+        vector<int>().swap(neighbours[i]);
+    }
+
+    // Union-find over the edges, then number components by lowest id
+    vector<int> parents(size);
+    for (int i = 0; i < size; i++) {
+        parents[i] = i;
+    }
+    for (int i = 0; i < size; i++) {
+        for (int e = m_offsets[i]; e < m_offsets[i + 1]; e++) {
+            int a = Find(parents, i);
+            int b = Find(parents, m_targets[e]);
+            if (a != b) {
+                parents[a < b ? b : a] = a < b ? a : b;
+            }
+        }
+    }
+    vector<int> numbers(size, -1);
+    m_component.assign(size, -1);
+    vector<int> sizes;
+    for (int i = 0; i < size; i++) {
+        int root = Find(parents, i);
+        if (numbers[root] < 0) {
+            numbers[root] = static_cast<int>(sizes.size());
+            sizes.push_back(0);
+        }
+        m_component[i] = numbers[root];
+        sizes[numbers[root]]++;
+    }
+    int components = static_cast<int>(sizes.size());
+    m_first.assign(components + 1, 0);
+    for (int c = 0; c < components; c++) {
+        m_first[c + 1] = m_first[c] + sizes[c];
+    }
+    m_members.assign(size, 0);
+    m_local.assign(size, 0);
+    vector<int> filled(components, 0);
+    for (int i = 0; i < size; i++) {
+        int c = m_component[i];
+        m_local[i] = filled[c]++;
+        m_members[m_first[c] + m_local[i]] = i;
+    }
+
+    // Level 1: each airport and its neighbours. A lone airport needs no
+    // bits, and a component whose rows do not fit in REACH_MAX_BYTES gets
+    // none (its queries search instead).
+    size_t bytes = 0;
+    m_hopLimit = 1;
+    m_components.resize(components);
+    for (int c = 0; c < components; c++) {
+        Component& component = m_components[c];
+        component.size = sizes[c];
+        component.words = (sizes[c] + 63) / 64;
+        component.saturated = sizes[c] == 1;
+        component.searched = false;
+        if (component.saturated) {
+            continue;
+        }
+        size_t needed = (size_t)component.size * component.words * sizeof(uint64_t);
+        if (bytes + needed > REACH_MAX_BYTES) {
+            component.searched = true;
+            m_hopLimit = 0;
+            continue;
+        }
+        component.levels.push_back(vector<uint64_t>((size_t)component.size * component.words, 0));
+        bytes += needed;
+    }
+    for (int i = 0; i < size; i++) {
+        Component& component = m_components[m_component[i]];
+        if (component.saturated || component.searched) {
+            continue;
+        }
+        uint64_t* row = &component.levels[0][(size_t)m_local[i] * component.words];
+        row[m_local[i] >> 6] |= 1ULL << (m_local[i] & 63);
+        for (int e = m_offsets[i]; e < m_offsets[i + 1]; e++) {
+            int local = m_local[m_targets[e]];
+            row[local >> 6] |= 1ULL << (local & 63);
+        }
+    }
+
+    // Level h: OR of the neighbours' rows at level h - 1
+    for (int h = 2; h <= REACH_MAX_HOPS; h++) {
+        size_t needed = 0;
+        for (int c = 0; c < components; c++) {
+            if (!m_components[c].saturated && !m_components[c].searched) {
+                needed += (size_t)m_components[c].size * m_components[c].words * sizeof(uint64_t);
+            }
+        }
+        if (needed == 0 || bytes + needed > REACH_MAX_BYTES) {
+            break;
+        }
+        bytes += needed;
+        for (int c = 0; c < components; c++) {
+            Component& component = m_components[c];
+            if (!component.saturated && !component.searched) {
+                component.levels.push_back(vector<uint64_t>((size_t)component.size * component.words, 0));
+            }
+        }
+        tasks.clear();
+        for (int t = 0; t < taskCount; t++) {
+            tasks.push_back([this, t, taskCount, size]() {
+                for (int p = static_cast<long>(size) * t / taskCount;
+                     p < static_cast<long>(size) * (t + 1) / taskCount; p++) {
+                    int i = m_members[p];
+                    Component& component = m_components[m_component[i]];
+                    if (component.saturated || component.searched) {
+                        continue;
+                    }
+                    int words = component.words;
+                    const vector<uint64_t>& last = component.levels[component.levels.size() - 2];
+                    uint64_t* row = &component.levels.back()[(size_t)m_local[i] * words];
+                    const uint64_t* own = &last[(size_t)m_local[i] * words];
+                    for (int w = 0; w < words; w++) {
+                        row[w] = own[w];
+                    }
+                    for (int e = m_offsets[i]; e < m_offsets[i + 1]; e++) {
+                        const uint64_t* other = &last[(size_t)m_local[m_targets[e]] * words];
+                        for (int w = 0; w < words; w++) {
+                            row[w] |= other[w];
+                        }
+                    }
+                }
+            });
+        }
+        Run(tasks);
+        // A level equal to the one before means every row is full
+        for (int c = 0; c < components; c++) {
+            Component& component = m_components[c];
+            if (component.saturated || component.searched) {
+                continue;
+            }
+            const vector<uint64_t>& last = component.levels[component.levels.size() - 2];
+            if (memcmp(last.data(), component.levels.back().data(), last.size() * sizeof(uint64_t)) == 0) {
+                bytes -= last.size() * sizeof(uint64_t);
+                component.levels.pop_back();
+                component.saturated = true;
+            }
+        }
+        if (m_hopLimit > 0) {
+            m_hopLimit = h;
+        }
+    }
+}
+
+bool ReachabilityIndex::IsBuilt() const {
+    return m_built;
+}
+
+bool ReachabilityIndex::Covers(double maxLeg) const {
+    if (!m_built || Bucket(maxLeg) != m_bucket) {
+        return false;
+    }
+    return m_unlimited || (maxLeg >= m_low && maxLeg < m_high);
+}
+
+bool ReachabilityIndex::Connected(int from, int to) const {
+    return m_component[from] == m_component[to];
+}
+
+bool ReachabilityIndex::Reachable(int from, int to, int hops) const {
+    if (from == to) {
+        return true;
+    }
+    if (hops < 1 || m_component[from] != m_component[to]) {
+        return false;
+    }
+    if (m_unlimited) {
+        return true;
+    }
+    const Component& component = m_components[m_component[from]];
+    int levels = static_cast<int>(component.levels.size());
+    if (hops > levels) {
+        if (component.saturated) {
+            return true;
+        }
+        return Search(from, to, hops) >= 0;
+    }
+    int local = m_local[to];
+    return (component.levels[hops - 1][(size_t)m_local[from] * component.words + (local >> 6)] >>
+            (local & 63)) & 1;
+}
+
+int ReachabilityIndex::MinHops(int from, int to) const {
+    if (from == to) {
+        return 0;
+    }
+    if (m_component[from] != m_component[to]) {
+        return -1;
+    }
+    if (m_unlimited) {
+        return 1;
+    }
+    // Levels only gain bits, so binary search for the first that has it
+    const Component& component = m_components[m_component[from]];
+    int low = 1;
+    int high = static_cast<int>(component.levels.size());
+    if (!Reachable(from, to, high)) {
+        return Search(from, to, numeric_limits<int>::max());
+    }
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (Reachable(from, to, middle)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+int ReachabilityIndex::Search(int from, int to, int maxHops) const {
+    vector<int> hops(m_component.size(), -1);
+    vector<int> queue;
+    queue.push_back(from);
+    hops[from] = 0;
+    for (int head = 0; head < static_cast<int>(queue.size()); head++) {
+        int v = queue[head];
+        if (hops[v] == maxHops) {
+            break;
+        }
+        for (int e = m_offsets[v]; e < m_offsets[v + 1]; e++) {
+            int w = m_targets[e];
+            if (hops[w] < 0) {
+                hops[w] = hops[v] + 1;
+                if (w == to) {
+                    return hops[w];
+                }
+                queue.push_back(w);
+            }
+        }
+    }
+    return -1;
+}
+
+int ReachabilityIndex::GetComponentCount() const {
+    return m_unlimited ? (m_component.empty() ? 0 : 1) : static_cast<int>(m_components.size());
+}
+
+int ReachabilityIndex::GetHopLimit() const {
+    return m_hopLimit;
+}
+
+size_t ReachabilityIndex::GetMemoryUsage() const {
+    size_t bytes = (m_offsets.capacity() + m_targets.capacity() + m_component.capacity() +
+                    m_local.capacity() + m_members.capacity() + m_first.capacity()) * sizeof(int);
+    for (int c = 0; c < static_cast<int>(m_components.size()); c++) {
+        for (int h = 0; h < static_cast<int>(m_components[c].levels.size()); h++) {
+            bytes += m_components[c].levels[h].capacity() * sizeof(uint64_t);
+        }
+    }
+    return bytes;
+}
+
+ReachabilityCache::ReachabilityCache(ThreadPool* pool) {
+    m_pool = pool;
+}
+
+const ReachabilityIndex& ReachabilityCache::Get(const AirportCatalog& catalog,
+                                                const SpatialIndex& index, double maxLeg) {
+    long bucket = ReachabilityIndex::Bucket(maxLeg);
+    int found = -1;
+    for (int i = 0; i < static_cast<int>(m_entries.size()) && found < 0; i++) {
+        if (m_entries[i].bucket == bucket) {
+            found = i;
+        }
+    }
+    if (found < 0) {
+        if (static_cast<int>(m_entries.size()) == REACH_CACHE_ENTRIES) {
+            m_entries.pop_back();
+        }
+        Entry entry;
+        entry.bucket = bucket;
+        entry.index.reset(new ReachabilityIndex());
+        m_entries.push_back(move(entry));
+        found = static_cast<int>(m_entries.size()) - 1;
+    }
+    // Most recently used to the front
+    for (int i = found; i > 0; i--) {
+        swap(m_entries[i], m_entries[i - 1]);
+    }
+    ReachabilityIndex& reach = *m_entries[0].index;
+    if (!reach.Covers(maxLeg)) {
+        reach.Build(catalog, index, maxLeg, m_pool);
+    }
+    return reach;
+}
+
+void ReachabilityCache::Clear() {
+    m_entries.clear();
+}
+
+size_t ReachabilityCache::GetMemoryUsage() const {
+    size_t bytes = 0;
+    for (int i = 0; i < static_cast<int>(m_entries.size()); i++) {
+        bytes += sizeof(ReachabilityIndex) + m_entries[i].index->GetMemoryUsage();
+    }
+    return bytes;
+}
@@ -0,0 +1,173 @@
+//Name: Reachability.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the ReachabilityIndex
+//      and ReachabilityCache classes
+//      For an aircraft that can fly at most maxLeg miles per leg, which
+//      airports can reach which within k legs. Airports are vertices and
+//      every pair within range is an (undirected) edge, as in RoutePlanner.
+//      Union-find splits the airports into connected components. Then,
+//      per component, one bitset row per airport holds the airports
+//      within h legs, for h = 1, 2, ... Row h of v is row h-1 of v ORed
+//      with row h-1 of each neighbour, a word at a time. Rows are built
+//      in parallel across source airports. Levels stop when a component
+//      is saturated (every row is the whole component), at REACH_MAX_HOPS,
+//      or at REACH_MAX_BYTES. Queries are a component compare and one bit
+//      test. A component whose first level alone does not fit in
+//      REACH_MAX_BYTES gets no bitsets, and its queries are answered by a
+//      breadth-first search over the edges.
+//      An index also records the range interval it is exact for (no
+//      pair of airports lies between), so ReachabilityCache can reuse it
+//      for any range in the same REACH_BUCKET_MILES bucket that falls
+//      inside that interval.
+
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "AirportCatalog.h"
+#include "SpatialIndex.h"
+#include "ThreadPool.h"
+using namespace std;
+
+//Constants
+const double REACH_BUCKET_MILES = 250.0; //Width of a cached range bucket
+const int REACH_MAX_HOPS = 16; //Most bitset levels per component
+const size_t REACH_MAX_BYTES = (size_t)256 << 20; //Most bytes of bitsets
+const int REACH_CACHE_ENTRIES = 4; //Ranges kept by ReachabilityCache
+const int REACH_TASKS_PER_THREAD = 4; //Build tasks per pool thread
+
+class ReachabilityIndex {
+ public:
+  // Name: ReachabilityIndex() - Default Constructor
+  // Desc: Builds an empty index
+  // Preconditions: None
+  // Postconditions: IsBuilt is false
+  ReachabilityIndex();
+  // Name: Build(AirportCatalog&, SpatialIndex&, double, ThreadPool*)
+  // Desc: Builds the components and bitsets for legs of at most maxLeg
+  //   miles (maxLeg <= 0 means unlimited: every airport is one leg from
+  //   every other). pool (may be nullptr) runs the per-airport work.
+  // Preconditions: Airports are loaded and the index is built from them
+  // Postconditions: Queries answer for maxLeg
+  void Build(const AirportCatalog& catalog, const SpatialIndex& index,
+             double maxLeg, ThreadPool* pool);
+  // Name: IsBuilt()
+  // Preconditions: None
+  // Postconditions: Returns true once Build has run
+  bool IsBuilt() const;
+  // Name: Covers(double)
+  // Desc: True if the index gives the same answers for maxLeg as for
+  //   the range it was built for (same bucket, same edges)
+  // Preconditions: None
+  // Postconditions: Returns whether the index can be reused
+  bool Covers(double maxLeg) const;
+  // Name: Connected(int, int)
+  // Desc: True if to can be reached from from with any number of legs
+  // Preconditions: IsBuilt() and both ids are valid
+  // Postconditions: Returns the answer in O(1)
+  bool Connected(int from, int to) const;
+  // Name: Reachable(int, int, int)
+  // Desc: True if to can be reached from from in at most hops legs.
+  //   O(1) up to GetHopLimit() legs (and for saturated components);
+  //   beyond that it falls back to a breadth-first search.
+  // Preconditions: IsBuilt() and both ids are valid
+  // Postconditions: Returns the answer
+  bool Reachable(int from, int to, int hops) const;
+  // Name: MinHops(int, int)
+  // Desc: Fewest legs from from to to (0 for the same airport)
+  // Preconditions: IsBuilt() and both ids are valid
+  // Postconditions: Returns the legs, or -1 if to cannot be reached
+  int MinHops(int from, int to) const;
+  // Name: GetComponentCount()
+  // Preconditions: IsBuilt()
+  // Postconditions: Returns the number of connected components
+  int GetComponentCount() const;
+  // Name: GetHopLimit()
+  // Desc: Legs answered from bitsets in every unsaturated component
+  // Preconditions: IsBuilt()
+  // Postconditions: Returns the limit (0 if some component has no bitsets)
+  int GetHopLimit() const;
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns the bytes used by the edges and bitsets
+  size_t GetMemoryUsage() const;
+  // Name: Bucket(double)
+  // Desc: REACH_BUCKET_MILES bucket of a range (-1 for unlimited)
+  // Preconditions: None
+  // Postconditions: Returns the bucket
+  static long Bucket(double maxLeg);
+ private:
+  //Bitsets of one component (local ids are positions in the component)
+  struct Component {
+    int size; //Airports in the component
+    int words; //64-bit words per row
+    vector<vector<uint64_t> > levels; //levels[h - 1]: row v is within h legs of v
+    bool saturated; //The last level is the whole component
+    bool searched; //No levels (over REACH_MAX_BYTES); queries search
+  };
+  // Name: Find(vector<int>&, int)
+  // Desc: Union-find root of v (with path halving)
+  static int Find(vector<int>& parents, int v);
+  // Name: Search(int, int, int)
+  // Desc: Breadth-first search for the fewest legs (up to maxHops)
+  int Search(int from, int to, int maxHops) const;
+  // Name: Run(vector<function<void()> >&)
+  // Desc: Runs tasks on m_pool, or here if there is no pool
+  void Run(vector<function<void()> >& tasks);
+  bool m_built; //Build has run
+  bool m_unlimited; //Built for unlimited range
+  double m_low; //Longest edge (ranges below it lose an edge)
+  double m_high; //Shortest pair not an edge (ranges from it gain one)
+  long m_bucket; //Bucket of the range built for
+  int m_hopLimit; //Levels built in every unsaturated component
+  ThreadPool* m_pool; //Pool for the current Build
+  vector<int> m_offsets; //Edges of i are [m_offsets[i], m_offsets[i + 1])
+  vector<int> m_targets;
+  vector<int> m_component; //Component of each airport
+  vector<int> m_local; //Position of each airport in its component
+  vector<int> m_members; //Airports of component c from m_first[c]
+  vector<int> m_first; //Start of each component in m_members
+  vector<Component> m_components;
+};
+
+class ReachabilityCache {
+ public:
+  // Name: ReachabilityCache(ThreadPool*)
+  // Desc: Builds an empty cache; pool (may be nullptr) builds indexes
+  // Preconditions: pool outlives the cache
+  // Postconditions: No ranges are cached
+  ReachabilityCache(ThreadPool* pool);
+  // Name: Get(AirportCatalog&, SpatialIndex&, double)
+  // Desc: An index valid for maxLeg: the cached one for its bucket if
+  //   it covers maxLeg, else a new one that replaces it (the least
+  //   recently used bucket goes once REACH_CACHE_ENTRIES are held)
+  // Preconditions: Airports are loaded and the index is built from them
+  // Postconditions: Returns the index (valid until the next Get or Clear)
+  const ReachabilityIndex& Get(const AirportCatalog& catalog, const SpatialIndex& index,
+                               double maxLeg);
+  // Name: Clear()
+  // Desc: Drops every cached index (when the airports change)
+  // Preconditions: None
+  // Postconditions: No ranges are cached
+  void Clear();
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns the bytes used by every cached index
+  size_t GetMemoryUsage() const;
+ private:
+  //One cached range
+  struct Entry {
+    long bucket; //Range bucket (-1 for unlimited)
+    unique_ptr<ReachabilityIndex> index;
+  };
+  ThreadPool* m_pool; //Builds indexes
+  vector<Entry> m_entries; //Most recently used first
+};
+
+#endif
@@ -1,10 +1,27 @@
 #include "Route.h"
+#include "Stats.h"
+#include <algorithm>
 
 Route::Route() {
     m_name = "";
     m_head = nullptr;
     m_tail = nullptr;
     m_size = 0;
+    m_airports = nullptr;
+    m_cache = nullptr;
+    m_miles = 0.0;
+    STATS_COUNT(STAT_ROUTES_CREATED, 1);
+}
+
+Route::Route(const vector<Airport*>* airports, const DistanceCache* cache) {
+    m_name = "";
+    m_head = nullptr;
+    m_tail = nullptr;
+    m_size = 0;
+    m_airports = airports;
+    m_cache = cache;
+    m_miles = 0.0;
+    STATS_COUNT(STAT_ROUTES_CREATED, 1);
 }
 
 Route::~Route() {
@@ -20,18 +37,77 @@ void Route::SetName(string name) {
     m_name = name;
 }
 
-void Route::InsertEnd(string code, string name, string city, string country, double north, double west) {
+void Route::InsertEnd(string code, string name, string city, string country, double north, double west, int id) {
+    if (m_airports != nullptr) {
+        // Indexed routes only hold airports from their table
+        if (id < 0 || id >= static_cast<int>(m_airports->size())) {
+            cout << "Invalid airport." << endl;
+            return;
+        }
+        InsertEnd(id);
+        return;
+    }
+    STATS_TIMER(STAT_ROUTE_EDIT);
+    STATS_COUNT(STAT_ROUTE_EDITS, 1);
     Airport* newAirport = new Airport(code, name, city, country, north, west);
+    newAirport->SetID(id);
     if (m_head == nullptr) {
         m_head = newAirport;
         m_tail = newAirport;
     } else {
+        m_legs.push_back(Leg(m_tail, newAirport));
+        m_miles += m_legs.back();
         m_tail->SetNext(newAirport);
         m_tail = newAirport;
     }
     m_size++;
 }
 
+void Route::InsertEnd(int id) {
+    STATS_TIMER(STAT_ROUTE_EDIT);
+    STATS_COUNT(STAT_ROUTE_EDITS, 1);
+    if (m_size > 0) {
+        m_legs.push_back(Leg((*m_airports)[m_ids.back()], (*m_airports)[id]));
+        m_miles += m_legs.back();
+    }
+    m_ids.push_back(static_cast<uint32_t>(id));
+    m_size++;
+}
+
+double Route::Leg(Airport* from, Airport* to) {
+    STATS_COUNT(STAT_DISTANCES, 1);
+    int fromID = from->GetID();
+    int toID = to->GetID();
+    if (m_cache != nullptr && m_cache->IsBuilt() && fromID >= 0 && toID >= 0 &&
+        fromID < m_cache->GetSize() && toID < m_cache->GetSize()) {
+        return m_cache->GetDistance(fromID, toID);
+    }
+    return Haversine(from->GetNorth(), from->GetWest(), to->GetNorth(), to->GetWest());
+}
+
+double Route::GetDistance() {
+    return m_miles;
+}
+
+double Route::GetLeg(int index) {
+    return m_legs[index];
+}
+
+bool Route::IsIndexed() {
+    return m_airports != nullptr;
+}
+
+int Route::GetID(int index) {
+    if (index < 0 || index >= m_size) {
+        cout << "Invalid index." << endl;
+        return -1;
+    }
+    if (m_airports != nullptr) {
+        return static_cast<int>(m_ids[index]);
+    }
+    return GetData(index)->GetID();
+}
+
 void Route::RemoveAirport(int index) {
     if (m_size <= 2) {
         cout << "Cannot remove airport. Route must have at least two airports." << endl;
@@ -42,6 +118,27 @@ void Route::RemoveAirport(int index) {
         cout << "Invalid index." << endl;
         return;
     }
+    STATS_TIMER(STAT_ROUTE_EDIT);
+    STATS_COUNT(STAT_ROUTE_EDITS, 1);
+
+    // Swap the legs into and out of the airport for one leg that skips it
+    if (index > 0) {
+        m_miles -= m_legs[index - 1];
+    }
+    if (index < m_size - 1) {
+        m_miles -= m_legs[index];
+    }
+
+    if (m_airports != nullptr) {
+        if (index > 0 && index < m_size - 1) {
+            m_legs[index - 1] = Leg((*m_airports)[m_ids[index - 1]], (*m_airports)[m_ids[index + 1]]);
+            m_miles += m_legs[index - 1];
+        }
+        m_legs.erase(m_legs.begin() + (index < m_size - 1 ? index : index - 1));
+        m_ids.erase(m_ids.begin() + index);
+        m_size--;
+        return;
+    }
 
     Airport* current = m_head;
     Airport* previous = nullptr;
@@ -49,6 +146,11 @@ void Route::RemoveAirport(int index) {
         previous = current;
         current = current->GetNext();
     }
+    if (previous != nullptr && current->GetNext() != nullptr) {
+        m_legs[index - 1] = Leg(previous, current->GetNext());
+        m_miles += m_legs[index - 1];
+    }
+    m_legs.erase(m_legs.begin() + (index < m_size - 1 ? index : index - 1));
 
     if (current == m_head) {
         m_head = current->GetNext();
@@ -68,10 +170,16 @@ string Route::GetName() {
 }
 
 string Route::UpdateName() {
+    if (m_airports != nullptr) {
+        if (m_size == 0) {
+            return "";
+        }
+        return string((*m_airports)[m_ids.front()]->GetCity()) + " to " + string((*m_airports)[m_ids.back()]->GetCity());
+    }
     if (m_head == nullptr || m_tail == nullptr) {
         return "";
     }
-    return m_head->GetCity() + " to " + m_tail->GetCity();
+    return string(m_head->GetCity()) + " to " + string(m_tail->GetCity());
 }
 
 int Route::GetSize() {
@@ -83,6 +191,15 @@ void Route::ReverseRoute() {
         cout << "Route must have at least two airports to be reversed." << endl;
         return;
     }
+    STATS_TIMER(STAT_ROUTE_EDIT);
+    STATS_COUNT(STAT_ROUTE_EDITS, 1);
+
+    // Same legs in the opposite order; the total does not change
+    reverse(m_legs.begin(), m_legs.end());
+    if (m_airports != nullptr) {
+        reverse(m_ids.begin(), m_ids.end());
+        return;
+    }
 
     Airport* previous = nullptr;
     Airport* current = m_head;
@@ -104,21 +221,35 @@ Airport* Route::GetData(int index) {
         cout << "Invalid index." << endl;
         return nullptr;
     }
+    STATS_COUNT(STAT_GETDATA_CALLS, 1);
+
+    if (m_airports != nullptr) {
+        return (*m_airports)[m_ids[index]];
+    }
 
     Airport* current = m_head;
     for (int i = 0; i < index; i++) {
         current = current->GetNext();
     }
+    STATS_COUNT(STAT_GETDATA_STEPS, index);
 
     return current;
 }
 
 void Route::DisplayRoute() {
-    if (m_head == nullptr) {
+    if (m_size == 0) {
         cout << "Route is empty." << endl;
         return;
     }
 
+    if (m_airports != nullptr) {
+        for (int i = 0; i < m_size; i++) {
+            Airport* current = (*m_airports)[m_ids[i]];
+            cout << current->GetCity() << ", " << current->GetCountry() << " (N" << current->GetNorth() << " W" << current->GetWest() << ")" << endl;
+        }
+        return;
+    }
+
     Airport* current = m_head;
     while (current != nullptr) {
         cout << current->GetCity() << ", " << current->GetCountry() << " (N" << current->GetNorth() << " W" << current->GetWest() << ")" << endl;
@@ -3,6 +3,11 @@
 //Date:    4/10/2024
 //Desc: This file contains the header details for the Route class
 //      A route is a linked list that uses airports as nodes
+//      An indexed route instead keeps 32-bit airport ids in a contiguous
+//      vector that points into the Navigator's airport table
+//      Either kind keeps the miles of each leg and the total, updated as
+//      airports are added, removed or reversed, so the length of a route
+//      is read in O(1)
 
 #ifndef ROUTE_H
 #define ROUTE_H
@@ -11,8 +16,11 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <vector>
+#include <cstdint>
 
 #include "Airport.h"
+#include "DistanceCache.h"
 using namespace std;
 
 class Route {
@@ -23,6 +31,15 @@ class Route {
   // Postconditions: Creates a new Route where m_head and m_tail
   //   point to nullptr and size = 0
   Route();
+  // Name: Route(vector<Airport*>*, DistanceCache*) - Overloaded Constructor
+  // Desc: Used to build a new indexed Route. Airports are stored as ids
+  //   into the given table rather than copied into new nodes, so indexed
+  //   access is O(1) and no strings are copied per stop.
+  //   Legs are looked up in cache when it is given and built.
+  // Preconditions: The table (and cache) outlive the route and the
+  //   table is not reordered
+  // Postconditions: Creates a new empty indexed Route
+  Route(const vector<Airport*>* airports, const DistanceCache* cache = nullptr);
   // Name: SetName(string)
   // Desc: Sets the name of the route (usually first
   //   airport to last airport)
@@ -36,13 +53,32 @@ class Route {
   // Postconditions: Route is deallocated (including all
   //   dynamically allocated airports) to have no memory leaks!
  ~Route();
-  // Name: InsertEnd (string, string, double double)
+  // Name: InsertEnd (string, string, double double, int)
   // Desc: Creates a new airport using the data passed to it.
   //   Inserts the new airport at the end of the route
+  //   The optional id is the airport's index in the Navigator's table
   // Preconditions: Takes in a Airport
   //                Requires a Route
   // Postconditions: Adds the new airport to the end of a route
-  void InsertEnd(string, string, string, string, double, double);
+  //   and its leg to the route's miles
+  void InsertEnd(string, string, string, string, double, double, int id = -1);
+  // Name: InsertEnd (int)
+  // Desc: Inserts the airport with the given id at the end of an
+  //   indexed route (no airport is allocated)
+  // Preconditions: Route is indexed and id is valid in its table
+  // Postconditions: Adds the airport id to the end of the route
+  //   and its leg to the route's miles
+  void InsertEnd(int id);
+  // Name: IsIndexed()
+  // Desc: Returns whether the route stores ids instead of nodes
+  // Preconditions: None
+  // Postconditions: Returns true for routes built with a table
+  bool IsIndexed();
+  // Name: GetID (int)
+  // Desc: Returns the table id of the airport at a specific index
+  // Preconditions: Index is less than the size of the route
+  // Postconditions: Returns the id (-1 if a node has no id)
+  int GetID(int index);
   // Name: RemoveAirport(int index)
   // Desc: Removes a airport from the route at the index provided
   //   Hint: Special cases (first airport, last airport, middle airport)
@@ -50,7 +86,8 @@ class Route {
   //   Cannot make route less than two airports. If the route has
   //   two or fewer airports, fails.
   // Postconditions: Name may be updated. Size is reduced.
-  //   Route has one less airport.
+  //   Route has one less airport. The legs on either side are
+  //   replaced by one leg (the other legs are not recomputed).
   void RemoveAirport(int airport);
   // Name: GetName()
   // Desc: Returns the name of the route (Usually starting
@@ -75,9 +112,24 @@ class Route {
   // Desc: Reverses a route
   // Preconditions: Reverses the Route
   // Postconditions: Route is reversed in place; nothing returned
+  //   The total miles are unchanged
   void ReverseRoute();
+  // Name: GetDistance()
+  // Desc: Returns the total miles of the route (O(1)). Kept up to date
+  //   by adding and subtracting legs, so after edits it can differ from
+  //   a fresh sum in the last few bits.
+  // Preconditions: None
+  // Postconditions: Returns the miles (0 for fewer than two airports)
+  double GetDistance();
+  // Name: GetLeg(int)
+  // Desc: Returns the miles from airport index to airport index + 1
+  // Preconditions: 0 <= index < GetSize() - 1
+  // Postconditions: Returns the leg's miles
+  double GetLeg(int index);
   // Name: GetData (int)
   // Desc: Returns an airport at a specific index
+  //   For an indexed route this is the table's airport (O(1));
+  //   it is not owned by the route and its next pointer is not used
   // Preconditions: Requires a Route
   // Postconditions: Returns the airport from specific item
   Airport* GetData(int index);
@@ -92,6 +144,14 @@ class Route {
   Airport *m_head; //Front of the Route (Starting Point)
   Airport *m_tail; //End of the Route (Ending Point)
   int m_size; //Total size of the Route
+  const vector<Airport*> *m_airports; //Airport table (nullptr for a linked route)
+  vector<uint32_t> m_ids; //Airport ids of an indexed route
+  const DistanceCache *m_cache; //Precomputed legs (nullptr if none)
+  vector<double> m_legs; //Miles of leg i (airport i to airport i + 1)
+  double m_miles; //Sum of m_legs
+  // Name: Leg(Airport*, Airport*)
+  // Desc: Miles between two airports (from m_cache when possible)
+  double Leg(Airport* from, Airport* to);
 };
 
 #endif
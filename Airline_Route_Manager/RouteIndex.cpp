@@ -0,0 +1,177 @@
+#include "RouteIndex.h"
+
+#include <algorithm>
+
+RouteIndex::RouteIndex() {
+}
+
+void RouteIndex::Clear() {
+    m_airports.clear();
+    m_legs.clear();
+}
+
+uint64_t RouteIndex::LegKey(int a, int b) {
+    if (a > b) {
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+
+CompressedBitmap& RouteIndex::Airport(int airport) {
+    if (airport >= static_cast<int>(m_airports.size())) {
+        m_airports.resize(airport + 1);
+    }
+    return m_airports[airport];
+}
+
+void RouteIndex::AddRoute(int route, const vector<int>& stops) {
+    int size = static_cast<int>(stops.size());
+    for (int i = 0; i < size; i++) {
+        Airport(stops[i]).Add(route);
+        if (i + 1 < size && stops[i] != stops[i + 1]) {
+            m_legs[LegKey(stops[i], stops[i + 1])].Add(route);
+        }
+    }
+}
+
+void RouteIndex::RemoveRoute(int route, const vector<int>& stops) {
+    int size = static_cast<int>(stops.size());
+    for (int i = 0; i < size; i++) {
+        if (stops[i] < static_cast<int>(m_airports.size())) {
+            m_airports[stops[i]].Remove(route);
+        }
+        if (i + 1 < size) {
+            unordered_map<uint64_t, CompressedBitmap>::iterator leg = m_legs.find(LegKey(stops[i], stops[i + 1]));
+            if (leg != m_legs.end()) {
+                leg->second.Remove(route);
+                if (leg->second.IsEmpty()) {
+                    m_legs.erase(leg);
+                }
+            }
+        }
+    }
+}
+
+void RouteIndex::Unpost(int route, int a, int b, const vector<int>& stops, int position) {
+    int size = static_cast<int>(stops.size());
+    // Still used elsewhere in the route? (skipping what is being removed)
+    for (int i = 0; i < size; i++) {
+        if (b < 0) {
+            if (i != position && stops[i] == a) {
+                return;
+            }
+        } else if (i + 1 < size && i != position - 1 && i != position &&
+                   LegKey(stops[i], stops[i + 1]) == LegKey(a, b)) {
+            return;
+        }
+    }
+    if (b < 0) {
+        m_airports[a].Remove(route);
+        return;
+    }
+    unordered_map<uint64_t, CompressedBitmap>::iterator leg = m_legs.find(LegKey(a, b));
+    if (leg != m_legs.end()) {
+        leg->second.Remove(route);
+        if (leg->second.IsEmpty()) {
+            m_legs.erase(leg);
+        }
+    }
+}
+
+void RouteIndex::RemoveStop(int route, const vector<int>& stops, int position) {
+    int size = static_cast<int>(stops.size());
+    int previous = position > 0 ? stops[position - 1] : -1;
+    int next = position + 1 < size ? stops[position + 1] : -1;
+    // The joining leg first, so Unpost sees it as still in use
+    if (previous >= 0 && next >= 0 && previous != next) {
+        m_legs[LegKey(previous, next)].Add(route);
+    }
+    bool joined = previous >= 0 && next >= 0;
+    Unpost(route, stops[position], -1, stops, position);
+    if (previous >= 0 && previous != stops[position] &&
+        !(joined && LegKey(previous, stops[position]) == LegKey(previous, next))) {
+        Unpost(route, previous, stops[position], stops, position);
+    }
+    if (next >= 0 && next != stops[position] &&
+        !(joined && LegKey(stops[position], next) == LegKey(previous, next))) {
+        Unpost(route, stops[position], next, stops, position);
+    }
+}
+
+void RouteIndex::RoutesThrough(const vector<int>& airports, vector<int>& routes) const {
+    routes.clear();
+    if (airports.empty()) {
+        return;
+    }
+    // Start from the shortest list so the intersection shrinks fastest
+    int smallest = 0;
+    for (int i = 0; i < static_cast<int>(airports.size()); i++) {
+        if (airports[i] < 0 || airports[i] >= static_cast<int>(m_airports.size())) {
+            return; // No route uses it
+        }
+        if (m_airports[airports[i]].GetCount() < m_airports[airports[smallest]].GetCount()) {
+            smallest = i;
+        }
+    }
+    CompressedBitmap result = m_airports[airports[smallest]];
+    for (int i = 0; i < static_cast<int>(airports.size()) && !result.IsEmpty(); i++) {
+        if (i != smallest) {
+            result.AndWith(m_airports[airports[i]]);
+        }
+    }
+    vector<uint32_t> values;
+    result.ToVector(values);
+    routes.assign(values.begin(), values.end());
+}
+
+void RouteIndex::RoutesSharingLegs(const vector<int>& stops, int minShared, int exclude,
+                                   vector<int>& routes, vector<int>& shared) const {
+    routes.clear();
+    shared.clear();
+    // Distinct legs of the query route
+    vector<uint64_t> keys;
+    for (int i = 0; i + 1 < static_cast<int>(stops.size()); i++) {
+        if (stops[i] != stops[i + 1]) {
+            keys.push_back(LegKey(stops[i], stops[i + 1]));
+        }
+    }
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+    // Count how many of the legs' posting lists each route is in
+    unordered_map<uint32_t, int> counts;
+    vector<uint32_t> values;
+    for (int i = 0; i < static_cast<int>(keys.size()); i++) {
+        unordered_map<uint64_t, CompressedBitmap>::const_iterator leg = m_legs.find(keys[i]);
+        if (leg == m_legs.end()) {
+            continue;
+        }
+        values.clear();
+        leg->second.ToVector(values);
+        for (int j = 0; j < static_cast<int>(values.size()); j++) {
+            counts[values[j]]++;
+        }
+    }
+    for (unordered_map<uint32_t, int>::iterator it = counts.begin(); it != counts.end(); ++it) {
+        if (it->second >= minShared && static_cast<int>(it->first) != exclude) {
+            routes.push_back(static_cast<int>(it->first));
+        }
+    }
+    sort(routes.begin(), routes.end());
+    for (int i = 0; i < static_cast<int>(routes.size()); i++) {
+        shared.push_back(counts[routes[i]]);
+    }
+}
+
+size_t RouteIndex::GetMemoryUsage() const {
+    size_t bytes = m_airports.capacity() * sizeof(CompressedBitmap);
+    for (int i = 0; i < static_cast<int>(m_airports.size()); i++) {
+        bytes += m_airports[i].GetMemoryUsage();
+    }
+    for (unordered_map<uint64_t, CompressedBitmap>::const_iterator it = m_legs.begin(); it != m_legs.end(); ++it) {
+        bytes += sizeof(*it) + it->second.GetMemoryUsage();
+    }
+    return bytes;
+}
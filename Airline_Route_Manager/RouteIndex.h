@@ -0,0 +1,82 @@
+//Name: RouteIndex.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RouteIndex class
+//      An inverted index from each airport, and from each leg, to the
+//      routes that use it. Route ids are positions in the Navigator's
+//      m_routes and each posting list is a CompressedBitmap. Legs are
+//      unordered pairs (A-B and B-A are the same leg), so reversing a
+//      route changes nothing in the index.
+
+#ifndef ROUTEINDEX_H
+#define ROUTEINDEX_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "CompressedBitmap.h"
+using namespace std;
+
+class RouteIndex {
+ public:
+  // Name: RouteIndex() - Default Constructor
+  // Desc: Builds an empty index
+  // Preconditions: None
+  // Postconditions: No routes are indexed
+  RouteIndex();
+  // Name: Clear()
+  // Preconditions: None
+  // Postconditions: No routes are indexed
+  void Clear();
+  // Name: AddRoute(int, vector<int>&)
+  // Desc: Indexes every airport and leg of a route
+  // Preconditions: stops are the route's airport ids in order
+  // Postconditions: route is in the posting list of each
+  void AddRoute(int route, const vector<int>& stops);
+  // Name: RemoveRoute(int, vector<int>&)
+  // Desc: Removes a route from every posting list it is in
+  // Preconditions: stops are the route's airport ids when it was indexed
+  // Postconditions: route is in no posting list
+  void RemoveRoute(int route, const vector<int>& stops);
+  // Name: RemoveStop(int, vector<int>&, int)
+  // Desc: Updates the index for removing stops[position] from a route:
+  //   only the airport and the legs on either side can leave, and the
+  //   leg joining its neighbours is added
+  // Preconditions: stops are the route's airport ids before the removal
+  // Postconditions: Index matches the route after the removal
+  void RemoveStop(int route, const vector<int>& stops, int position);
+  // Name: RoutesThrough(vector<int>&, vector<int>&)
+  // Desc: Routes that pass through every airport given (intersection)
+  // Preconditions: None
+  // Postconditions: routes holds the route ids in increasing order
+  void RoutesThrough(const vector<int>& airports, vector<int>& routes) const;
+  // Name: RoutesSharingLegs(vector<int>&, int, int, vector<int>&, vector<int>&)
+  // Desc: Routes with at least minShared of the distinct legs in stops
+  //   (route exclude is skipped, -1 for none)
+  // Preconditions: minShared >= 1
+  // Postconditions: routes holds the route ids in increasing order and
+  //   shared how many of the legs each one has
+  void RoutesSharingLegs(const vector<int>& stops, int minShared, int exclude,
+                         vector<int>& routes, vector<int>& shared) const;
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns the bytes allocated by the posting lists
+  size_t GetMemoryUsage() const;
+ private:
+  // Name: LegKey(int, int)
+  // Desc: Same key for a-b and b-a
+  static uint64_t LegKey(int a, int b);
+  // Name: Airport(int)
+  // Desc: Posting list of an airport (grown on demand)
+  CompressedBitmap& Airport(int airport);
+  // Name: Unpost(int, int, int, vector<int>&, int)
+  // Desc: Drops route from an airport's (b < 0) or leg's posting list
+  //   unless stops still uses it away from the removed position
+  void Unpost(int route, int a, int b, const vector<int>& stops, int position);
+  vector<CompressedBitmap> m_airports; //Routes through each airport id
+  unordered_map<uint64_t, CompressedBitmap> m_legs; //Routes using each leg
+};
+
+#endif
@@ -0,0 +1,349 @@
+#include "RouteNetwork.h"
+
+#include <algorithm>
+#include <functional>
+
+RouteNetwork::RouteNetwork(ThreadPool* pool) {
+    m_pool = pool;
+    m_size = 0;
+    m_edges = 0;
+    // Caches start out of date
+    m_version = 1;
+    m_flatVersion = 0;
+    m_betweennessVersion = 0;
+    m_weakVersion = 0;
+    m_strongVersion = 0;
+}
+
+void RouteNetwork::Reset(int airports) {
+    m_size = airports;
+    m_legUses.clear();
+    m_out.assign(airports, vector<int>());
+    m_in.assign(airports, vector<int>());
+    m_edges = 0;
+    m_version++;
+}
+
+uint64_t RouteNetwork::LegKey(int from, int to) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) | static_cast<uint32_t>(to);
+}
+
+void RouteNetwork::AddLeg(int from, int to) {
+    if (from == to) {
+        return;
+    }
+    if (m_legUses[LegKey(from, to)]++ > 0) {
+        return; // Already an edge; only the count changes
+    }
+    m_out[from].insert(lower_bound(m_out[from].begin(), m_out[from].end(), to), to);
+    m_in[to].insert(lower_bound(m_in[to].begin(), m_in[to].end(), from), from);
+    m_edges++;
+    m_version++;
+}
+
+void RouteNetwork::RemoveLeg(int from, int to) {
+    unordered_map<uint64_t, int>::iterator leg = m_legUses.find(LegKey(from, to));
+    if (leg == m_legUses.end()) {
+        return;
+    }
+    if (--leg->second > 0) {
+        return;
+    }
+    m_legUses.erase(leg);
+    m_out[from].erase(lower_bound(m_out[from].begin(), m_out[from].end(), to));
+    m_in[to].erase(lower_bound(m_in[to].begin(), m_in[to].end(), from));
+    m_edges--;
+    m_version++;
+}
+
+void RouteNetwork::AddRoute(const vector<int>& stops) {
+    for (int i = 0; i + 1 < static_cast<int>(stops.size()); i++) {
+        AddLeg(stops[i], stops[i + 1]);
+    }
+}
+
+void RouteNetwork::RemoveRoute(const vector<int>& stops) {
+    for (int i = 0; i + 1 < static_cast<int>(stops.size()); i++) {
+        RemoveLeg(stops[i], stops[i + 1]);
+    }
+}
+
+void RouteNetwork::RemoveStop(const vector<int>& stops, int position) {
+    int size = static_cast<int>(stops.size());
+    // Add the joining leg first so a leg that survives is never dropped
+    if (position > 0 && position + 1 < size) {
+        AddLeg(stops[position - 1], stops[position + 1]);
+    }
+    if (position > 0) {
+        RemoveLeg(stops[position - 1], stops[position]);
+    }
+    if (position + 1 < size) {
+        RemoveLeg(stops[position], stops[position + 1]);
+    }
+}
+
+int RouteNetwork::GetOutDegree(int id) const {
+    return static_cast<int>(m_out[id].size());
+}
+
+int RouteNetwork::GetInDegree(int id) const {
+    return static_cast<int>(m_in[id].size());
+}
+
+int RouteNetwork::GetEdgeCount() const {
+    return m_edges;
+}
+
+void RouteNetwork::Flatten() {
+    if (m_flatVersion == m_version) {
+        return;
+    }
+    m_outOffsets.assign(m_size + 1, 0);
+    m_inOffsets.assign(m_size + 1, 0);
+    m_outTargets.clear();
+    m_inTargets.clear();
+    m_outTargets.reserve(m_edges);
+    m_inTargets.reserve(m_edges);
+    for (int i = 0; i < m_size; i++) {
+        m_outTargets.insert(m_outTargets.end(), m_out[i].begin(), m_out[i].end());
+        m_inTargets.insert(m_inTargets.end(), m_in[i].begin(), m_in[i].end());
+        m_outOffsets[i + 1] = static_cast<int>(m_outTargets.size());
+        m_inOffsets[i + 1] = static_cast<int>(m_inTargets.size());
+    }
+    m_flatVersion = m_version;
+}
+
+void RouteNetwork::Accumulate(int source, BrandesState& state) const {
+    vector<int>& distance = state.distance;
+    vector<double>& paths = state.paths;
+    vector<double>& dependency = state.dependency;
+    vector<int>& order = state.order;
+
+    // Breadth-first: count the shortest paths to every airport
+    order.clear();
+    order.push_back(source);
+    distance[source] = 0;
+    paths[source] = 1.0;
+    for (int head = 0; head < static_cast<int>(order.size()); head++) {
+        int v = order[head];
+        for (int e = m_outOffsets[v]; e < m_outOffsets[v + 1]; e++) {
+            int w = m_outTargets[e];
+            if (distance[w] < 0) {
+                distance[w] = distance[v] + 1;
+                order.push_back(w);
+            }
+            if (distance[w] == distance[v] + 1) {
+                paths[w] += paths[v];
+            }
+        }
+    }
+
+    // Farthest first: pass each airport's share back to its predecessors
+    // (found through the in-edges, so no predecessor lists are stored)
+    for (int i = static_cast<int>(order.size()) - 1; i > 0; i--) {
+        int w = order[i];
+        double share = (1.0 + dependency[w]) / paths[w];
+        for (int e = m_inOffsets[w]; e < m_inOffsets[w + 1]; e++) {
+            int v = m_inTargets[e];
+            if (distance[v] == distance[w] - 1) {
+                dependency[v] += paths[v] * share;
+            }
+        }
+        state.scores[w] += dependency[w];
+    }
+
+    // Reset only what this source touched
+    for (int i = 0; i < static_cast<int>(order.size()); i++) {
+        distance[order[i]] = -1;
+        paths[order[i]] = 0.0;
+        dependency[order[i]] = 0.0;
+    }
+}
+
+const vector<double>& RouteNetwork::Betweenness() {
+    if (m_betweennessVersion == m_version) {
+        return m_betweenness;
+    }
+    Flatten();
+    vector<int> sources;
+    for (int i = 0; i < m_size; i++) {
+        if (m_outOffsets[i + 1] > m_outOffsets[i]) {
+            sources.push_back(i);
+        }
+    }
+
+    int threads = m_pool == nullptr ? 1 : m_pool->GetThreadCount();
+    int tasks = threads == 1 ? 1 : threads * NETWORK_TASKS_PER_THREAD;
+    if (tasks > static_cast<int>(sources.size())) {
+        tasks = sources.size() == 0 ? 1 : static_cast<int>(sources.size());
+    }
+    // Each task sums into its own scores; no locks or atomics
+    vector<BrandesState> states(tasks);
+    vector<function<void()> > work;
+    int count = static_cast<int>(sources.size());
+    for (int t = 0; t < tasks; t++) {
+        work.push_back([this, &states, &sources, t, tasks, count]() {
+            BrandesState& state = states[t];
+            state.distance.assign(m_size, -1);
+            state.paths.assign(m_size, 0.0);
+            state.dependency.assign(m_size, 0.0);
+            state.scores.assign(m_size, 0.0);
+            // Interleaved so every task gets a mix of sources
+            for (int i = t; i < count; i += tasks) {
+                Accumulate(sources[i], state);
+            }
+        });
+    }
+    if (tasks == 1) {
+        work[0]();
+    } else {
+        m_pool->Run(work);
+    }
+
+    // Summed in task order so the result does not depend on timing
+    m_betweenness.assign(m_size, 0.0);
+    for (int t = 0; t < tasks; t++) {
+        for (int i = 0; i < m_size; i++) {
+            m_betweenness[i] += states[t].scores[i];
+        }
+    }
+    m_betweennessVersion = m_version;
+    return m_betweenness;
+}
+
+void RouteNetwork::Hubs(int k, vector<int>& ids) {
+    const vector<double>& scores = Betweenness();
+    ids.clear();
+    for (int i = 0; i < m_size; i++) {
+        if (!m_out[i].empty() || !m_in[i].empty()) {
+            ids.push_back(i);
+        }
+    }
+    int keep = k < static_cast<int>(ids.size()) ? k : static_cast<int>(ids.size());
+    partial_sort(ids.begin(), ids.begin() + keep, ids.end(), [&scores](int a, int b) {
+        return scores[a] != scores[b] ? scores[a] > scores[b] : a < b;
+    });
+    ids.resize(keep);
+}
+
+const vector<int>& RouteNetwork::WeakComponents() {
+    if (m_weakVersion == m_version) {
+        return m_weak;
+    }
+    Flatten();
+    m_weak.assign(m_size, -1);
+    vector<int> stack;
+    int components = 0;
+    for (int start = 0; start < m_size; start++) {
+        if (m_weak[start] >= 0 || (m_out[start].empty() && m_in[start].empty())) {
+            continue;
+        }
+        m_weak[start] = components;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int e = m_outOffsets[v]; e < m_outOffsets[v + 1]; e++) {
+                if (m_weak[m_outTargets[e]] < 0) {
+                    m_weak[m_outTargets[e]] = components;
+                    stack.push_back(m_outTargets[e]);
+                }
+            }
+            for (int e = m_inOffsets[v]; e < m_inOffsets[v + 1]; e++) {
+                if (m_weak[m_inTargets[e]] < 0) {
+                    m_weak[m_inTargets[e]] = components;
+                    stack.push_back(m_inTargets[e]);
+                }
+            }
+        }
+        components++;
+    }
+    m_weakVersion = m_version;
+    return m_weak;
+}
+
+const vector<int>& RouteNetwork::StrongComponents() {
+    if (m_strongVersion == m_version) {
+        return m_strong;
+    }
+    Flatten();
+    // Tarjan's algorithm with an explicit stack (routes can be long
+    // enough to overflow a recursive one)
+    m_strong.assign(m_size, -1);
+    vector<int> index(m_size, -1);
+    vector<int> low(m_size, 0);
+    vector<bool> onStack(m_size, false);
+    vector<int> members; //Airports not yet given a component
+    vector<pair<int, int> > calls; //(airport, next edge to try)
+    int counter = 0;
+    int components = 0;
+    for (int start = 0; start < m_size; start++) {
+        if (index[start] >= 0 || (m_out[start].empty() && m_in[start].empty())) {
+            continue;
+        }
+        calls.push_back(make_pair(start, m_outOffsets[start]));
+        index[start] = low[start] = counter++;
+        members.push_back(start);
+        onStack[start] = true;
+        while (!calls.empty()) {
+            int v = calls.back().first;
+            int& edge = calls.back().second;
+            if (edge < m_outOffsets[v + 1]) {
+                int w = m_outTargets[edge++];
+                if (index[w] < 0) {
+                    index[w] = low[w] = counter++;
+                    members.push_back(w);
+                    onStack[w] = true;
+                    calls.push_back(make_pair(w, m_outOffsets[w]));
+                } else if (onStack[w] && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+            // Every edge of v is done
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = members.back();
+                    members.pop_back();
+                    onStack[w] = false;
+                    m_strong[w] = components;
+                } while (w != v);
+                components++;
+            }
+            calls.pop_back();
+            if (!calls.empty() && low[v] < low[calls.back().first]) {
+                low[calls.back().first] = low[v];
+            }
+        }
+    }
+    m_strongVersion = m_version;
+    return m_strong;
+}
+
+NetworkStats RouteNetwork::GetStats() {
+    NetworkStats stats = {0, m_edges, 0, 0, 0};
+    const vector<int>& weak = WeakComponents();
+    const vector<int>& strong = StrongComponents();
+    vector<int> sizes;
+    for (int i = 0; i < m_size; i++) {
+        if (weak[i] < 0) {
+            continue;
+        }
+        stats.airports++;
+        if (weak[i] >= static_cast<int>(sizes.size())) {
+            sizes.resize(weak[i] + 1, 0);
+        }
+        sizes[weak[i]]++;
+        if (strong[i] + 1 > stats.strongComponents) {
+            stats.strongComponents = strong[i] + 1;
+        }
+    }
+    stats.components = static_cast<int>(sizes.size());
+    for (int i = 0; i < static_cast<int>(sizes.size()); i++) {
+        if (sizes[i] > stats.largest) {
+            stats.largest = sizes[i];
+        }
+    }
+    return stats;
+}
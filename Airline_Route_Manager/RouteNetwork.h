@@ -0,0 +1,149 @@
+//Name: RouteNetwork.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RouteNetwork class
+//      The union of every route as a directed graph: airports are
+//      vertices and each leg A->B of any route is an edge (counted once
+//      however many routes fly it). Edges are kept as per-airport sorted
+//      lists that are updated leg by leg as routes change; the CSR
+//      (compressed sparse row) arrays used by the analytics are only
+//      flattened again when an edge appears or disappears.
+//      Hub metrics: in/out degree (always current), betweenness
+//      centrality by Brandes' algorithm (hops, run in parallel across
+//      source airports with one accumulator per task), and weakly and
+//      strongly connected components. Results are cached until the
+//      edges change.
+
+#ifndef ROUTENETWORK_H
+#define ROUTENETWORK_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "ThreadPool.h"
+using namespace std;
+
+//Constants
+const int NETWORK_TASKS_PER_THREAD = 4; //Betweenness tasks per pool thread
+
+//Summary of the network
+struct NetworkStats {
+  int airports; //Airports on at least one leg
+  int edges; //Distinct directed legs
+  int components; //Weakly connected components (of airports on a leg)
+  int largest; //Airports in the largest weak component
+  int strongComponents; //Strongly connected components
+};
+
+class RouteNetwork {
+ public:
+  // Name: RouteNetwork(ThreadPool*)
+  // Desc: Builds an empty network; pool (may be nullptr) runs betweenness
+  // Preconditions: pool outlives the network
+  // Postconditions: No airports or edges
+  RouteNetwork(ThreadPool* pool);
+  // Name: Reset(int)
+  // Desc: Empties the network and sizes it for airports airports
+  // Preconditions: airports >= 0
+  // Postconditions: No edges
+  void Reset(int airports);
+  // Name: AddRoute(vector<int>&)
+  // Desc: Adds one use of every leg stops[i] -> stops[i + 1]
+  // Preconditions: Every id is below the airport count
+  // Postconditions: Each leg is an edge
+  void AddRoute(const vector<int>& stops);
+  // Name: RemoveRoute(vector<int>&)
+  // Desc: Removes one use of every leg; a leg no route uses stops
+  //   being an edge
+  // Preconditions: stops were added with AddRoute
+  // Postconditions: The route's legs are released
+  void RemoveRoute(const vector<int>& stops);
+  // Name: RemoveStop(vector<int>&, int)
+  // Desc: Updates the legs for removing stops[position] from a route:
+  //   the legs on either side go and the leg joining its neighbours comes
+  // Preconditions: stops are the route's airport ids before the removal
+  // Postconditions: Network matches the route after the removal
+  void RemoveStop(const vector<int>& stops, int position);
+  // Name: GetOutDegree / GetInDegree(int)
+  // Preconditions: id is below the airport count
+  // Postconditions: Returns the distinct airports flown to / from id
+  int GetOutDegree(int id) const;
+  int GetInDegree(int id) const;
+  // Name: GetEdgeCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of distinct directed legs
+  int GetEdgeCount() const;
+  // Name: Betweenness()
+  // Desc: For every airport, the number of shortest (fewest-legs) paths
+  //   between other airports that pass through it, each pair's paths
+  //   sharing one unit (Brandes). Sources are split over the pool.
+  // Preconditions: None
+  // Postconditions: Returns one score per airport (cached)
+  const vector<double>& Betweenness();
+  // Name: Hubs(int, vector<int>&)
+  // Desc: The k airports with the highest betweenness (ties by id)
+  // Preconditions: k >= 0
+  // Postconditions: ids holds up to k airports on at least one leg
+  void Hubs(int k, vector<int>& ids);
+  // Name: WeakComponents()
+  // Desc: Component number of each airport when legs are undirected
+  //   (-1 for airports on no leg)
+  // Preconditions: None
+  // Postconditions: Returns one number per airport (cached)
+  const vector<int>& WeakComponents();
+  // Name: StrongComponents()
+  // Desc: Component number of each airport where every airport in a
+  //   component can reach every other along the legs (-1 if on no leg)
+  // Preconditions: None
+  // Postconditions: Returns one number per airport (cached)
+  const vector<int>& StrongComponents();
+  // Name: GetStats()
+  // Preconditions: None
+  // Postconditions: Returns the network summary
+  NetworkStats GetStats();
+ private:
+  //Work space for one Brandes task
+  struct BrandesState {
+    vector<int> distance; //Legs from the source (-1 if not reached)
+    vector<double> paths; //Shortest paths from the source
+    vector<double> dependency; //Share of later paths through each airport
+    vector<int> order; //Airports in the order reached
+    vector<double> scores; //This task's betweenness sums
+  };
+  // Name: LegKey(int, int)
+  // Desc: Key of the directed leg from -> to
+  static uint64_t LegKey(int from, int to);
+  // Name: AddLeg / RemoveLeg(int, int)
+  // Desc: Counts one more / one less use of a leg
+  void AddLeg(int from, int to);
+  void RemoveLeg(int from, int to);
+  // Name: Flatten()
+  // Desc: Rebuilds the CSR arrays if the edges changed since the last time
+  void Flatten();
+  // Name: Accumulate(int, BrandesState&)
+  // Desc: Adds one source's dependencies to state.scores
+  void Accumulate(int source, BrandesState& state) const;
+  int m_size; //Number of airports
+  unordered_map<uint64_t, int> m_legUses; //Routes flying each leg (> 0)
+  vector<vector<int> > m_out; //Sorted airports each airport flies to
+  vector<vector<int> > m_in; //Sorted airports that fly to each airport
+  int m_edges; //Distinct directed legs
+  unsigned m_version; //Changes whenever an edge appears or disappears
+  //CSR arrays (valid when m_flatVersion == m_version)
+  vector<int> m_outOffsets; //Out-edges of i are [m_outOffsets[i], m_outOffsets[i+1])
+  vector<int> m_outTargets;
+  vector<int> m_inOffsets; //In-edges, same layout
+  vector<int> m_inTargets;
+  unsigned m_flatVersion;
+  //Cached results and the version they were computed for
+  vector<double> m_betweenness;
+  unsigned m_betweennessVersion;
+  vector<int> m_weak;
+  unsigned m_weakVersion;
+  vector<int> m_strong;
+  unsigned m_strongVersion;
+  ThreadPool *m_pool; //Threads for betweenness (may be nullptr)
+};
+
+#endif
@@ -0,0 +1,270 @@
+#include "RouteOptimizer.h"
+
+#include <algorithm>
+#include <functional>
+
+//Constants
+const double OPT_EPSILON = 1e-7; //Smallest saving (miles) worth a move
+
+RouteOptimizer::RouteOptimizer(const AirportCatalog& catalog, const DistanceCache& cache,
+                               ThreadPool* pool)
+    : m_catalog(catalog), m_cache(cache), m_pool(pool) {
+}
+
+double RouteOptimizer::Distance(int a, int b) const {
+    if (!m_matrix.empty()) {
+        return m_matrix[(size_t)a * m_stops.size() + b];
+    }
+    if (m_cache.IsBuilt()) {
+        return m_cache.GetDistance(m_stops[a], m_stops[b]);
+    }
+    return Haversine(m_catalog.GetNorth(m_stops[a]), m_catalog.GetWest(m_stops[a]),
+                     m_catalog.GetNorth(m_stops[b]), m_catalog.GetWest(m_stops[b]));
+}
+
+double RouteOptimizer::Estimate(int a, int b) const {
+    if (!m_matrix.empty() || m_cache.IsBuilt()) {
+        return Distance(a, b); // Already a lookup
+    }
+    return OptimizerEstimateModel::Distance(m_catalog.GetNorth(m_stops[a]), m_catalog.GetWest(m_stops[a]),
+                                            m_catalog.GetNorth(m_stops[b]), m_catalog.GetWest(m_stops[b]));
+}
+
+double RouteOptimizer::Edge(int i) const {
+    if (i + 1 >= static_cast<int>(m_order.size())) {
+        return 0.0; // Open end: no edge after the last stop
+    }
+    return Distance(m_order[i], m_order[i + 1]);
+}
+
+void RouteOptimizer::Prepare(const vector<int>& ids) {
+    int size = static_cast<int>(ids.size());
+    m_stops = ids;
+    m_order.resize(size);
+    for (int i = 0; i < size; i++) {
+        m_order[i] = i;
+    }
+    m_matrix.clear();
+    // The cache is already a matrix; otherwise build one for short routes
+    if (m_cache.IsBuilt() || size > OPT_MATRIX_MAX) {
+        return;
+    }
+    vector<double> norths(size), wests(size);
+    for (int i = 0; i < size; i++) {
+        norths[i] = m_catalog.GetNorth(ids[i]);
+        wests[i] = m_catalog.GetWest(ids[i]);
+    }
+    m_matrix.resize((size_t)size * size);
+    for (int i = 0; i < size; i++) {
+        BatchDistanceFrom(norths[i], wests[i], norths.data(), wests.data(),
+                          &m_matrix[(size_t)i * size], size);
+    }
+}
+
+double RouteOptimizer::Length() const {
+    double miles = 0.0;
+    for (int i = 0; i + 1 < static_cast<int>(m_order.size()); i++) {
+        miles += Edge(i);
+    }
+    return miles;
+}
+
+void RouteOptimizer::NearestNeighbour(bool fixEnd) {
+    int size = static_cast<int>(m_order.size());
+    int last = fixEnd ? size - 1 : -1;
+    vector<bool> visited(size, false);
+    visited[0] = true;
+    if (last >= 0) {
+        visited[last] = true;
+    }
+    int current = 0;
+    int filled = 1;
+    int free = fixEnd ? size - 1 : size;
+    for (; filled < free; filled++) {
+        // Closest unvisited stop (ties go to the earlier stop)
+        int best = -1;
+        double bestMiles = 0.0;
+        for (int i = 1; i < size; i++) {
+            if (!visited[i]) {
+                double miles = Estimate(current, i);
+                if (best < 0 || miles < bestMiles) {
+                    best = i;
+                    bestMiles = miles;
+                }
+            }
+        }
+        visited[best] = true;
+        m_order[filled] = best;
+        current = best;
+    }
+    if (last >= 0) {
+        m_order[size - 1] = last;
+    }
+}
+
+RouteOptimizer::Move RouteOptimizer::BestTwoOpt(int begin, int end, bool fixEnd) const {
+    Move best = {0.0, -1, -1, -1, false};
+    int size = static_cast<int>(m_order.size());
+    int lastJ = fixEnd ? size - 2 : size - 1;
+    // Reversing [i + 1, j] swaps edges (i, i+1) and (j, j+1)
+    // for (i, j) and (i+1, j+1)
+    for (int i = begin; i < end && i < size - 2; i++) {
+        int a = m_order[i];
+        int b = m_order[i + 1];
+        double removed = Edge(i);
+        for (int j = i + 2; j <= lastJ; j++) {
+            double added = Distance(a, m_order[j]);
+            if (j + 1 < size) {
+                added += Distance(b, m_order[j + 1]);
+            }
+            double delta = added - removed - Edge(j);
+            if (delta < best.delta) {
+                best.delta = delta;
+                best.first = i + 1;
+                best.last = j;
+            }
+        }
+    }
+    return best;
+}
+
+RouteOptimizer::Move RouteOptimizer::BestOrOpt(int begin, int end, bool fixEnd) const {
+    Move best = {0.0, -1, -1, -1, false};
+    int size = static_cast<int>(m_order.size());
+    int lastStop = fixEnd ? size - 2 : size - 1;
+    for (int first = begin < 1 ? 1 : begin; first < end; first++) {
+        for (int length = 1; length <= OPT_SEGMENT_MAX; length++) {
+            int last = first + length - 1;
+            if (last > lastStop) {
+                break;
+            }
+            int before = m_order[first - 1];
+            int head = m_order[first];
+            int tail = m_order[last];
+            // Taking the run out joins its neighbours directly
+            double saved = Edge(first - 1) + Edge(last);
+            if (last + 1 < size) {
+                saved -= Distance(before, m_order[last + 1]);
+            }
+            // Put it back between target and target + 1 (either way round)
+            for (int target = 0; target < size; target++) {
+                if (target >= first - 1 && target <= last) {
+                    target = last; // Skip the run and its own gap
+                    continue;
+                }
+                if (fixEnd && target == size - 1) {
+                    break; // Nothing may follow the fixed last stop
+                }
+                int p = m_order[target];
+                double forward = Distance(p, head);
+                double backward = Distance(p, tail);
+                if (target + 1 < size) {
+                    int q = m_order[target + 1];
+                    double gap = Distance(p, q);
+                    forward += Distance(tail, q) - gap;
+                    backward += Distance(head, q) - gap;
+                }
+                double delta = forward - saved;
+                if (delta < best.delta) {
+                    best = {delta, first, last, target, false};
+                }
+                delta = backward - saved;
+                if (length > 1 && delta < best.delta) {
+                    best = {delta, first, last, target, true};
+                }
+            }
+        }
+    }
+    return best;
+}
+
+RouteOptimizer::Move RouteOptimizer::BestMove(bool twoOpt, bool fixEnd) {
+    int size = static_cast<int>(m_order.size());
+    int threads = m_pool == nullptr ? 1 : m_pool->GetThreadCount();
+    if (threads == 1 || size < OPT_PARALLEL_MIN) {
+        return twoOpt ? BestTwoOpt(0, size, fixEnd) : BestOrOpt(0, size, fixEnd);
+    }
+
+    // Several slices per thread since early rows of 2-opt cost more
+    int slices = threads * 4;
+    vector<Move> found(slices);
+    vector<function<void()> > tasks;
+    for (int s = 0; s < slices; s++) {
+        int begin = (int)((long)size * s / slices);
+        int end = (int)((long)size * (s + 1) / slices);
+        tasks.push_back([this, &found, s, begin, end, twoOpt, fixEnd]() {
+            found[s] = twoOpt ? BestTwoOpt(begin, end, fixEnd) : BestOrOpt(begin, end, fixEnd);
+        });
+    }
+    m_pool->Run(tasks);
+
+    // Same answer as one scan: earliest slice wins a tie
+    Move best = found[0];
+    for (int s = 1; s < slices; s++) {
+        if (found[s].delta < best.delta) {
+            best = found[s];
+        }
+    }
+    return best;
+}
+
+void RouteOptimizer::Apply(const Move& move, bool twoOpt) {
+    if (twoOpt) {
+        reverse(m_order.begin() + move.first, m_order.begin() + move.last + 1);
+        return;
+    }
+    vector<int> run(m_order.begin() + move.first, m_order.begin() + move.last + 1);
+    if (move.reversed) {
+        reverse(run.begin(), run.end());
+    }
+    m_order.erase(m_order.begin() + move.first, m_order.begin() + move.last + 1);
+    int insert = move.target + 1;
+    if (move.target > move.last) {
+        insert -= static_cast<int>(run.size());
+    }
+    m_order.insert(m_order.begin() + insert, run.begin(), run.end());
+}
+
+OptimizeStats RouteOptimizer::Optimize(vector<int>& ids, bool fixEnd, double budgetMs) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Prepare(ids);
+    OptimizeStats stats = {Length(), 0.0, 0, true};
+    stats.after = stats.before;
+    int size = static_cast<int>(ids.size());
+    if (size < (fixEnd ? 4 : 3)) {
+        return stats; // Only one possible order
+    }
+
+    // Start from the greedy order unless the given one is already shorter
+    vector<int> given = m_order;
+    NearestNeighbour(fixEnd);
+    if (Length() > stats.before) {
+        m_order = given;
+    }
+
+    stats.finished = false;
+    while (chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() < budgetMs) {
+        Move move = BestMove(true, fixEnd);
+        bool twoOpt = true;
+        if (move.delta >= -OPT_EPSILON) {
+            move = BestMove(false, fixEnd);
+            twoOpt = false;
+        }
+        if (move.delta >= -OPT_EPSILON) {
+            stats.finished = true; // No move helps: local optimum
+            break;
+        }
+        Apply(move, twoOpt);
+        stats.moves++;
+    }
+
+    stats.after = Length();
+    if (stats.after > stats.before) {
+        m_order = given; // Rounding only; never return a longer route
+        stats.after = stats.before;
+    }
+    for (int i = 0; i < size; i++) {
+        ids[i] = m_stops[m_order[i]];
+    }
+    return stats;
+}
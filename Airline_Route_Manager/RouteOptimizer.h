@@ -0,0 +1,108 @@
+//Name: RouteOptimizer.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RouteOptimizer class
+//      The optimizer reorders the stops of a route to shorten it (an open
+//      travelling-salesman path). The first stop stays first and,
+//      optionally, the last stays last. It builds a nearest-neighbour
+//      order, then improves it with 2-opt (reverse a stretch) and Or-opt
+//      (move a run of 1-3 stops) until no move helps or time runs out.
+//      Each step applies the best move found. For long routes the
+//      candidate moves are scored in parallel; the choice does not
+//      depend on the thread count.
+
+#ifndef ROUTEOPTIMIZER_H
+#define ROUTEOPTIMIZER_H
+
+#include <vector>
+#include <chrono>
+
+#include "AirportCatalog.h"
+#include "DistanceCache.h"
+#include "ThreadPool.h"
+#include "DistanceModel.h"
+using namespace std;
+
+//Cheap model for picking the nearest-neighbour order when there is no
+//matrix or cache; every saving is still scored with exact distances
+typedef EquirectangularModel<Miles> OptimizerEstimateModel;
+
+//Constants
+const int OPT_MATRIX_MAX = 1500; //Most stops given their own distance matrix
+const int OPT_PARALLEL_MIN = 200; //Fewest stops scored in parallel
+const int OPT_SEGMENT_MAX = 3; //Longest run of stops moved by Or-opt
+const double OPT_BUDGET_MS = 1000.0; //Default time budget (milliseconds)
+
+//Result of one Optimize call
+struct OptimizeStats {
+  double before; //Miles of the stops in the order given
+  double after; //Miles of the optimized order
+  int moves; //2-opt and Or-opt moves applied
+  bool finished; //False if the time budget ran out first
+};
+
+class RouteOptimizer {
+ public:
+  // Name: RouteOptimizer(AirportCatalog&, DistanceCache&, ThreadPool*)
+  // Desc: Builds an optimizer over the catalog's airports. Distances come
+  //   from the cache when it is built; pool (may be nullptr) is used to
+  //   score moves on long routes.
+  // Preconditions: catalog, cache and pool outlive the optimizer
+  // Postconditions: Ready to optimize
+  RouteOptimizer(const AirportCatalog& catalog, const DistanceCache& cache,
+                 ThreadPool* pool);
+  // Name: Optimize(vector<int>&, bool, double)
+  // Desc: Reorders ids (airport ids in route order) to shorten the route.
+  //   ids[0] stays first; ids.back() stays last if fixEnd.
+  //   Stops after budgetMs milliseconds even if moves remain.
+  // Preconditions: Every id is valid in the catalog
+  // Postconditions: ids holds the same stops in the new order; never
+  //   longer than before. Returns the miles before and after.
+  OptimizeStats Optimize(vector<int>& ids, bool fixEnd, double budgetMs);
+ private:
+  //Best move found by a scan (delta < 0 if it shortens the route)
+  struct Move {
+    double delta; //Change in miles
+    int first; //2-opt: reverse [first, last]; Or-opt: run [first, last]
+    int last;
+    int target; //Or-opt: insert after this position
+    bool reversed; //Or-opt: run is inserted backwards
+  };
+  // Name: Distance(int, int)
+  // Desc: Miles between stops a and b (positions in m_stops)
+  double Distance(int a, int b) const;
+  // Name: Estimate(int, int)
+  // Desc: Distance or, without a matrix or cache, OptimizerEstimateModel
+  double Estimate(int a, int b) const;
+  // Name: Edge(int)
+  // Desc: Miles from m_order[i] to m_order[i + 1] (0 past the end)
+  double Edge(int i) const;
+  // Name: Prepare(vector<int>&)
+  // Desc: Copies the stops and builds the local matrix for short routes
+  void Prepare(const vector<int>& ids);
+  // Name: NearestNeighbour(bool)
+  // Desc: Greedy order: always travel to the closest stop not yet visited
+  void NearestNeighbour(bool fixEnd);
+  // Name: Length()
+  // Desc: Miles of m_order
+  double Length() const;
+  // Name: BestTwoOpt / BestOrOpt(int, int, bool)
+  // Desc: Best move whose first edge starts in [begin, end)
+  Move BestTwoOpt(int begin, int end, bool fixEnd) const;
+  Move BestOrOpt(int begin, int end, bool fixEnd) const;
+  // Name: BestMove(bool, bool)
+  // Desc: Best 2-opt (twoOpt) or Or-opt move over the whole route,
+  //   split across m_pool for long routes
+  Move BestMove(bool twoOpt, bool fixEnd);
+  // Name: Apply(Move&, bool)
+  // Desc: Changes m_order by a move
+  void Apply(const Move& move, bool twoOpt);
+  const AirportCatalog& m_catalog; //Coordinates by airport id
+  const DistanceCache& m_cache; //Precomputed distances (if built)
+  ThreadPool *m_pool; //Threads for scoring moves (may be nullptr)
+  vector<int> m_stops; //Airport id of each stop, in the original order
+  vector<int> m_order; //Current order (positions in m_stops)
+  vector<double> m_matrix; //Square stop-to-stop miles (short routes)
+};
+
+#endif
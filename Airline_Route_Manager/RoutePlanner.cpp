@@ -0,0 +1,208 @@
+#include "RoutePlanner.h"
+#include "Haversine.h"
+
+#include <limits>
+
+RoutePlanner::RoutePlanner() {
+    m_catalog = nullptr;
+    m_cache = nullptr;
+    m_maxLeg = 0.0;
+    m_built = false;
+    m_generation = 0;
+}
+
+void RoutePlanner::Build(const AirportCatalog& catalog, double maxLeg,
+                         const DistanceCache& cache, const SpatialIndex& index) {
+    int size = catalog.GetSize();
+    m_catalog = &catalog;
+    m_cache = cache.IsBuilt() && cache.GetSize() == size ? &cache : nullptr;
+    m_maxLeg = maxLeg;
+
+    m_offsets.assign(size + 1, 0);
+    m_targets.clear();
+    m_weights.clear();
+    if (maxLeg > 0) {
+        vector<int> neighbours;
+        vector<double> miles;
+        for (int i = 0; i < size; i++) {
+            // Only airports in range are visited, not the whole table
+            index.Within(catalog.GetNorth(i), catalog.GetWest(i), maxLeg, neighbours, miles);
+            for (int j = 0; j < static_cast<int>(neighbours.size()); j++) {
+                if (neighbours[j] != i) {
+                    m_targets.push_back(neighbours[j]);
+                    m_weights.push_back(miles[j]);
+                }
+            }
+            m_offsets[i + 1] = static_cast<int>(m_targets.size());
+        }
+    }
+
+    m_gScore.assign(size, 0.0);
+    m_parent.assign(size, -1);
+    m_stamp.assign(size, 0);
+    m_labelAt.assign(size, -1);
+    m_generation = 0;
+    m_open.Resize(size);
+    m_built = true;
+}
+
+bool RoutePlanner::IsBuilt() const {
+    return m_built;
+}
+
+double RoutePlanner::GetMaxLeg() const {
+    return m_maxLeg;
+}
+
+int RoutePlanner::GetEdgeCount() const {
+    return static_cast<int>(m_targets.size());
+}
+
+double RoutePlanner::Distance(int id1, int id2) const {
+    if (m_cache != nullptr) {
+        return m_cache->GetDistance(id1, id2);
+    }
+    return PlannerBoundModel::Distance(m_catalog->GetNorth(id1), m_catalog->GetWest(id1),
+                                       m_catalog->GetNorth(id2), m_catalog->GetWest(id2));
+}
+
+void RoutePlanner::NewGeneration() {
+    m_generation++;
+    if (m_generation == 0) {
+        m_stamp.assign(m_stamp.size(), 0);
+        m_generation = 1;
+    }
+}
+
+double RoutePlanner::Plan(int start, int goal, vector<int>& path) {
+    path.clear();
+    if (start == goal) {
+        path.push_back(start);
+        return 0.0;
+    }
+    // Unlimited range: the direct leg is the shortest route
+    if (m_maxLeg <= 0) {
+        path.push_back(start);
+        path.push_back(goal);
+        return Distance(start, goal);
+    }
+
+    NewGeneration();
+    m_open.Clear();
+
+    m_gScore[start] = 0.0;
+    m_parent[start] = -1;
+    m_stamp[start] = m_generation;
+    m_open.Push(start, Distance(start, goal));
+
+    bool found = false;
+    while (!m_open.IsEmpty()) {
+        int current = m_open.Pop();
+        if (current == goal) {
+            found = true;
+            break;
+        }
+        double g = m_gScore[current];
+        for (int e = m_offsets[current]; e < m_offsets[current + 1]; e++) {
+            int next = m_targets[e];
+            double tentative = g + m_weights[e];
+            if (m_stamp[next] != m_generation || tentative < m_gScore[next]) {
+                m_stamp[next] = m_generation;
+                m_gScore[next] = tentative;
+                m_parent[next] = current;
+                // Re-queues closed airports too, in case rounding made the
+                // heuristic slightly inconsistent
+                m_open.Push(next, tentative + Distance(next, goal));
+            }
+        }
+    }
+    if (!found) {
+        return -1.0;
+    }
+
+    for (int id = goal; id != -1; id = m_parent[id]) {
+        path.push_back(id);
+    }
+    // Path was collected goal to start
+    for (int i = 0, j = static_cast<int>(path.size()) - 1; i < j; i++, j--) {
+        int temp = path[i];
+        path[i] = path[j];
+        path[j] = temp;
+    }
+    return m_gScore[goal];
+}
+
+int RoutePlanner::Pareto(int start, int goal, int maxHops, vector<ParetoPath>& frontier) {
+    frontier.clear();
+    if (start == goal) {
+        frontier.push_back({0, 0.0, vector<int>(1, start)});
+        return 1;
+    }
+    // Unlimited range: the direct leg is shortest and has fewest legs
+    if (m_maxLeg <= 0) {
+        vector<int> path;
+        path.push_back(start);
+        path.push_back(goal);
+        frontier.push_back({1, Distance(start, goal), path});
+        return 1;
+    }
+
+    NewGeneration();
+    m_labels.clear();
+    m_marked.clear();
+    m_labels.push_back({start, -1, 0, 0.0});
+    m_gScore[start] = 0.0;
+    m_stamp[start] = m_generation;
+    m_labelAt[start] = 0;
+    m_marked.push_back(0);
+    double goalMiles = numeric_limits<double>::infinity();
+
+    for (int hops = 1; hops <= maxHops && !m_marked.empty(); hops++) {
+        m_nextMarked.clear();
+        for (int m = 0; m < static_cast<int>(m_marked.size()); m++) {
+            // Copied: push_back below may move the labels
+            Label from = m_labels[m_marked[m]];
+            for (int e = m_offsets[from.airport]; e < m_offsets[from.airport + 1]; e++) {
+                int next = m_targets[e];
+                double miles = from.miles + m_weights[e];
+                bool seen = m_stamp[next] == m_generation;
+                // Dominated by a label with fewer (or as many) legs
+                if (seen && miles >= m_gScore[next]) {
+                    continue;
+                }
+                // Every longer route through next is at least this far
+                if (miles + Distance(next, goal) - PARETO_EPSILON >= goalMiles) {
+                    continue;
+                }
+                m_gScore[next] = miles;
+                m_stamp[next] = m_generation;
+                if (seen && m_labels[m_labelAt[next]].hops == hops) {
+                    // Improved again this round: overwrite, no new label
+                    m_labels[m_labelAt[next]].miles = miles;
+                    m_labels[m_labelAt[next]].parent = m_marked[m];
+                    continue;
+                }
+                m_labelAt[next] = static_cast<int>(m_labels.size());
+                m_labels.push_back({next, m_marked[m], hops, miles});
+                // Going on from the goal only adds legs and miles
+                if (next != goal) {
+                    m_nextMarked.push_back(m_labelAt[next]);
+                }
+            }
+        }
+
+        // A goal label from this round is shorter than all with fewer legs
+        if (m_stamp[goal] == m_generation && m_labels[m_labelAt[goal]].hops == hops) {
+            goalMiles = m_gScore[goal];
+            ParetoPath found = {hops, goalMiles, vector<int>(hops + 1)};
+            int label = m_labelAt[goal];
+            for (int i = hops; i >= 0; i--) {
+                found.path[i] = m_labels[label].airport;
+                label = m_labels[label].parent;
+            }
+            frontier.push_back(found);
+        }
+        m_marked.swap(m_nextMarked);
+    }
+    return static_cast<int>(frontier.size());
+}
@@ -0,0 +1,129 @@
+//Name: RoutePlanner.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RoutePlanner class
+//      The planner finds the shortest route between two airports when no
+//      single leg may be longer than a maximum range. Airports are vertices
+//      and every pair within range is an edge weighted by its distance.
+//      Edges are stored as flat CSR (compressed sparse row) arrays and
+//      searched with A* using the great-circle distance to the goal.
+//      Pareto lists every route that is the shortest for its number of
+//      legs: each round adds one leg (as in RAPTOR) and keeps a label
+//      only if no route with fewer legs reached that airport as cheaply.
+
+#ifndef ROUTEPLANNER_H
+#define ROUTEPLANNER_H
+
+#include <vector>
+
+#include "AirportCatalog.h"
+#include "DistanceCache.h"
+#include "SpatialIndex.h"
+#include "BinaryHeap.h"
+#include "DistanceModel.h"
+using namespace std;
+
+//Model for the A* heuristic and the Pareto goal bound when the cache is
+//not built. It must never exceed the great circle or routes would be
+//missed. (The chord is cheaper but looser; A* then expands more
+//airports than the trig it saves.)
+typedef HaversineModel<Miles> PlannerBoundModel;
+static_assert(PlannerBoundModel::LOWER_BOUND, "the planner's bound must never overestimate");
+
+//Constants
+const int PARETO_MAX_HOPS = 8; //Default most legs searched by Pareto
+const double PARETO_EPSILON = 1e-6; //Slack (miles) for rounding in the goal bound
+
+//One route on the distance / legs frontier
+struct ParetoPath {
+  int hops; //Legs in the route
+  double miles; //Total miles
+  vector<int> path; //Airport ids from start to goal
+};
+
+class RoutePlanner {
+ public:
+  // Name: RoutePlanner() - Default Constructor
+  // Desc: Builds a planner with no airports
+  // Preconditions: None
+  // Postconditions: IsBuilt is false
+  RoutePlanner();
+  // Name: Build(AirportCatalog&, double, DistanceCache&, SpatialIndex&)
+  // Desc: Builds the CSR edge arrays for every pair of airports at most
+  //   maxLeg miles apart (maxLeg <= 0 means unlimited range, which needs
+  //   no edges since the direct leg is always shortest). Each airport's
+  //   neighbours come from a radius query on the spatial index.
+  //   The cache (when built) serves the A* heuristic.
+  // Preconditions: Airports are loaded; the cache and index are built
+  //   from the same catalog, which outlives the planner's use
+  // Postconditions: Planner is ready for Plan with this range
+  void Build(const AirportCatalog& catalog, double maxLeg,
+             const DistanceCache& cache, const SpatialIndex& index);
+  // Name: IsBuilt()
+  // Preconditions: None
+  // Postconditions: Returns true once Build has run
+  bool IsBuilt() const;
+  // Name: GetMaxLeg()
+  // Preconditions: None
+  // Postconditions: Returns the range the edges were built for
+  double GetMaxLeg() const;
+  // Name: GetEdgeCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of directed edges
+  int GetEdgeCount() const;
+  // Name: Plan(int, int, vector<int>&)
+  // Desc: A* search from start to goal. The heuristic is the great-circle
+  //   distance to the goal, which never overestimates, so the result
+  //   is the shortest route within range.
+  // Preconditions: IsBuilt() and both ids are valid
+  // Postconditions: Fills path with airport ids from start to goal and
+  //   returns the total miles, or returns -1 if goal is unreachable
+  double Plan(int start, int goal, vector<int>& path);
+  // Name: Pareto(int, int, int, vector<ParetoPath>&)
+  // Desc: Finds every route from start to goal with at most maxHops legs
+  //   that no other route beats on both miles and legs. Round k extends
+  //   the airports improved in round k - 1 by one leg. A new label is
+  //   dropped at once if an earlier round reached the airport in no
+  //   more miles, or if it plus the straight line to the goal cannot
+  //   beat the goal's best so far. Labels live in m_labels, which keeps
+  //   its memory between queries.
+  // Preconditions: IsBuilt(), both ids are valid and maxHops >= 1
+  // Postconditions: Fills frontier in increasing legs (decreasing miles)
+  //   and returns its size (0 if goal is unreachable in maxHops legs)
+  int Pareto(int start, int goal, int maxHops, vector<ParetoPath>& frontier);
+ private:
+  //One step of a Pareto route: reached airport in hops legs and miles
+  struct Label {
+    int airport; //Airport reached
+    int parent; //Label this one extends (index into m_labels, -1 at start)
+    int hops; //Legs from start
+    double miles; //Miles from start
+  };
+  // Name: Distance(int, int)
+  // Desc: Distance between two airports (cache or PlannerBoundModel)
+  double Distance(int id1, int id2) const;
+  // Name: NewGeneration()
+  // Desc: Starts a search without clearing every airport's state
+  void NewGeneration();
+  const DistanceCache* m_cache; //Distance cache the edges were built from
+  const AirportCatalog* m_catalog; //Coordinates of each airport
+  vector<int> m_offsets; //Edges of airport i are [m_offsets[i], m_offsets[i+1])
+  vector<int> m_targets; //Destination airport of each edge
+  vector<double> m_weights; //Miles of each edge
+  double m_maxLeg; //Range the edges were built for (<= 0 is unlimited)
+  bool m_built; //True once Build has run
+  //Search state reused between queries (reset by generation stamps)
+  vector<double> m_gScore; //Best known miles from start
+  vector<int> m_parent; //Previous airport on the best path
+  vector<unsigned> m_stamp; //Generation in which m_gScore was set
+  unsigned m_generation; //Current search generation
+  BinaryHeap m_open; //Open set keyed by g + h
+  //Pareto state reused between queries (m_gScore holds the best miles
+  //at any number of legs so far)
+  vector<Label> m_labels; //Every label of the current query
+  vector<int> m_labelAt; //Latest label of each airport
+  vector<int> m_marked; //Labels improved in the last round
+  vector<int> m_nextMarked; //Labels improved in this round
+};
+
+#endif
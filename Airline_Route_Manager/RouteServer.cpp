@@ -0,0 +1,306 @@
+#include "RouteServer.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+int RouteServer::s_wake = -1;
+
+RouteServer::RouteServer(Navigator& navigator, bool allowEdits)
+    : m_nowhere(nullptr), m_driver(navigator, m_nowhere, BATCH_JSON) {
+    m_driver.SetReadOnly(!allowEdits);
+    m_listen = -1;
+    m_epoll = -1;
+    m_wake = -1;
+    m_connectionCount = 0;
+    m_requestCount = 0;
+}
+
+RouteServer::~RouteServer() {
+    for (unordered_map<int, unique_ptr<Connection> >::iterator it = m_connections.begin();
+         it != m_connections.end(); ++it) {
+        close(it->first);
+    }
+    if (m_listen >= 0) {
+        close(m_listen);
+        unlink(m_path.c_str());
+    }
+    if (m_epoll >= 0) {
+        close(m_epoll);
+    }
+    if (m_wake >= 0) {
+        close(m_wake);
+    }
+}
+
+bool RouteServer::Fail(const string& what) {
+    m_error = what + ": " + strerror(errno);
+    return false;
+}
+
+void RouteServer::Stop(int) {
+    uint64_t one = 1;
+    if (s_wake >= 0) {
+        ssize_t written = write(s_wake, &one, sizeof(one));
+        (void)written; // Nothing can be done about a failure in a handler
+    }
+}
+
+bool RouteServer::Listen(const string& path) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        m_error = "socket path must be 1 to " + to_string(sizeof(address.sun_path) - 1) + " bytes";
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size());
+    // A socket file nobody is listening on is left over from a crash
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        return Fail("socket");
+    }
+    bool inUse = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    close(probe);
+    if (inUse) {
+        m_error = path + " is in use by another server";
+        return false;
+    }
+    unlink(path.c_str());
+    m_listen = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listen < 0) {
+        return Fail("socket");
+    }
+    if (bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(m_listen);
+        m_listen = -1;
+        return Fail("bind " + path);
+    }
+    m_path = path;
+    if (listen(m_listen, SERVER_BACKLOG) < 0) {
+        return Fail("listen");
+    }
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll < 0 || m_wake < 0) {
+        return Fail("epoll");
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = m_listen;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listen, &event);
+    event.data.fd = m_wake;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+    return true;
+}
+
+bool RouteServer::Serve() {
+    s_wake = m_wake;
+    struct sigaction action;
+    struct sigaction oldInterrupt;
+    struct sigaction oldTerminate;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = Stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, &oldInterrupt);
+    sigaction(SIGTERM, &action, &oldTerminate);
+
+    bool ok = true;
+    bool running = true;
+    epoll_event events[SERVER_MAX_EVENTS];
+    while (running) {
+        int count = epoll_wait(m_epoll, events, SERVER_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = Fail("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == m_wake) {
+                running = false;
+            } else if (fd == m_listen) {
+                Accept();
+            } else {
+                unordered_map<int, unique_ptr<Connection> >::iterator it = m_connections.find(fd);
+                if (it == m_connections.end()) {
+                    continue; // Closed earlier in this batch of events
+                }
+                Connection& connection = *it->second;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    ReadInput(connection);
+                }
+                // Answer and send until the client stops taking answers
+                bool more = true;
+                while (more) {
+                    more = HandleRequests(connection);
+                    WriteOutput(connection);
+                    more = more && connection.output.empty();
+                }
+                Update(connection);
+            }
+        }
+    }
+
+    sigaction(SIGINT, &oldInterrupt, nullptr);
+    sigaction(SIGTERM, &oldTerminate, nullptr);
+    s_wake = -1;
+    return ok;
+}
+
+void RouteServer::Accept() {
+    while (true) {
+        int fd = accept4(m_listen, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once every waiting client is in
+        }
+        unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        connection->input.resize(SERVER_INPUT_BYTES);
+        connection->begin = 0;
+        connection->end = 0;
+        connection->sent = 0;
+        connection->lines = 0;
+        connection->events = EPOLLIN;
+        connection->closing = false;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        m_connections[fd] = move(connection);
+        m_connectionCount++;
+    }
+}
+
+void RouteServer::ReadInput(Connection& connection) {
+    while (!connection.closing) {
+        if (connection.end == connection.input.size()) {
+            if (connection.begin == 0) {
+                return; // Full of one request; HandleRequests rejects it
+            }
+            // Move the partial request to the front to make room
+            memmove(connection.input.data(), connection.input.data() + connection.begin,
+                    connection.end - connection.begin);
+            connection.end -= connection.begin;
+            connection.begin = 0;
+        }
+        ssize_t bytes = read(connection.fd, connection.input.data() + connection.end,
+                             connection.input.size() - connection.end);
+        if (bytes > 0) {
+            connection.end += bytes;
+        } else if (bytes == 0 || (errno != EAGAIN && errno != EINTR)) {
+            connection.closing = true; // Hung up; answer what was sent
+        } else if (errno == EAGAIN) {
+            return;
+        }
+    }
+}
+
+bool RouteServer::HandleRequests(Connection& connection) {
+    while (connection.begin < connection.end) {
+        if (connection.output.size() - connection.sent >= SERVER_OUTPUT_LIMIT) {
+            return true;
+        }
+        const char* start = connection.input.data() + connection.begin;
+        size_t length = connection.end - connection.begin;
+        const char* newline = static_cast<const char*>(memchr(start, '\n', length));
+        if (newline == nullptr) {
+            if (connection.closing) {
+                // Last request without a newline
+                m_driver.RunCommand(string_view(start, length), ++connection.lines, connection.output);
+                m_requestCount++;
+                connection.begin = connection.end;
+            } else if (connection.begin == 0 && connection.end == connection.input.size()) {
+                connection.output += "{\"ok\":false,\"error\":\"request longer than " +
+                    to_string(SERVER_INPUT_BYTES) + " bytes\"}\n";
+                connection.begin = connection.end;
+                connection.closing = true;
+            }
+            break;
+        }
+        m_driver.RunCommand(string_view(start, newline - start), ++connection.lines, connection.output);
+        m_requestCount++;
+        connection.begin += newline - start + 1;
+    }
+    if (connection.begin == connection.end) {
+        connection.begin = 0;
+        connection.end = 0;
+    }
+    return false;
+}
+
+void RouteServer::WriteOutput(Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t bytes = send(connection.fd, connection.output.data() + connection.sent,
+                             connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (bytes > 0) {
+            connection.sent += bytes;
+        } else if (bytes < 0 && errno == EINTR) {
+            continue;
+        } else if (bytes < 0 && errno == EAGAIN) {
+            break;
+        } else {
+            // The client is gone; drop what it will never read
+            connection.closing = true;
+            connection.output.clear();
+            connection.sent = 0;
+            connection.begin = connection.end;
+            return;
+        }
+    }
+    if (connection.sent == connection.output.size()) {
+        // Reuse the buffer's capacity for the next answers
+        connection.output.clear();
+        connection.sent = 0;
+    }
+}
+
+void RouteServer::Update(Connection& connection) {
+    bool pending = connection.sent < connection.output.size();
+    if (connection.closing && !pending && connection.begin == connection.end) {
+        int fd = connection.fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        m_connections.erase(fd);
+        return;
+    }
+    // Read while there is room for more answers and more requests
+    unsigned events = 0;
+    if (!connection.closing && connection.output.size() - connection.sent < SERVER_OUTPUT_LIMIT &&
+        (connection.begin > 0 || connection.end < connection.input.size())) {
+        events |= EPOLLIN;
+    }
+    if (pending) {
+        events |= EPOLLOUT;
+    }
+    if (events != connection.events) {
+        epoll_event event;
+        event.events = events;
+        event.data.fd = connection.fd;
+        epoll_ctl(m_epoll, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.events = events;
+    }
+}
+
+string RouteServer::GetError() const {
+    return m_error;
+}
+
+long RouteServer::GetConnectionCount() const {
+    return m_connectionCount;
+}
+
+long RouteServer::GetRequestCount() const {
+    return m_requestCount;
+}
@@ -0,0 +1,128 @@
+//Name: RouteServer.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RouteServer class
+//      Long-running server mode. The catalog is loaded once and batch
+//      commands (see BatchDriver.h) are answered over a Unix domain
+//      socket: each request is one line and each answer one JSON line,
+//      in order, with "line" counting the connection's requests. Clients
+//      may pipeline as many requests as they like.
+//      Blank and comment lines are skipped and get no answer.
+//      One thread runs an epoll loop over the listening socket, every
+//      client and an eventfd that the SIGINT/SIGTERM handler writes to
+//      (whichever thread gets the signal). Each connection keeps its own
+//      input and output buffers: requests are parsed as views into the
+//      input buffer and answers are appended straight to the output
+//      buffer, so nothing is copied in between. A client with
+//      SERVER_OUTPUT_LIMIT bytes of unsent answers is not read from until
+//      it catches up.
+//      Every client shares one Navigator, so by default the server is
+//      read-only (see BatchDriver::SetReadOnly): no client can add routes
+//      that are never freed, change another client's routes or make the
+//      server open files. Clients can still plan and score routes; the
+//      answers are not stored. allowEdits turns the other commands back
+//      on for trusted clients; routes they add are shared and kept until
+//      exit.
+
+#ifndef ROUTESERVER_H
+#define ROUTESERVER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <ostream>
+
+#include "Navigator.h"
+#include "BatchDriver.h"
+using namespace std;
+
+//Constants
+const int SERVER_BACKLOG = 128; //Connections waiting to be accepted
+const int SERVER_MAX_EVENTS = 64; //epoll events handled per wait
+const size_t SERVER_INPUT_BYTES = 1 << 16; //Input buffer (longest request line)
+const size_t SERVER_OUTPUT_LIMIT = 1 << 20; //Unsent bytes that pause reading
+
+class RouteServer {
+ public:
+  // Name: RouteServer(Navigator&, bool)
+  // Desc: Builds a server that answers commands against navigator
+  //   (read-only unless allowEdits)
+  // Preconditions: navigator is loaded
+  // Postconditions: Not listening yet
+  RouteServer(Navigator& navigator, bool allowEdits);
+  // Name: ~RouteServer() - Destructor
+  // Desc: Closes every connection and removes the socket file
+  // Preconditions: None
+  // Postconditions: All descriptors are closed
+  ~RouteServer();
+  // Name: Listen(string&)
+  // Desc: Binds a Unix domain socket at path (replacing a stale one)
+  // Preconditions: path is shorter than sockaddr_un's sun_path
+  // Postconditions: Returns false (see GetError) if it cannot listen
+  bool Listen(const string& path);
+  // Name: Serve()
+  // Desc: Runs the event loop until SIGINT or SIGTERM
+  // Preconditions: Listen succeeded
+  // Postconditions: Returns false (see GetError) if the loop failed
+  bool Serve();
+  // Name: GetError()
+  // Preconditions: None
+  // Postconditions: Returns why Listen or Serve failed
+  string GetError() const;
+  // Name: GetConnectionCount / GetRequestCount
+  // Preconditions: None
+  // Postconditions: Returns the connections accepted and requests answered
+  long GetConnectionCount() const;
+  long GetRequestCount() const;
+ private:
+  //One client
+  struct Connection {
+    int fd; //Client socket
+    vector<char> input; //Bytes read; requests are views into it
+    size_t begin; //Start of the first unparsed request
+    size_t end; //End of the bytes read
+    string output; //Answers (sent from offset sent on)
+    size_t sent; //Bytes of output already sent
+    int lines; //Requests answered
+    unsigned events; //epoll events registered
+    bool closing; //Client hung up (or broke the protocol); finish sending
+  };
+  // Name: Accept()
+  // Desc: Accepts every waiting client
+  void Accept();
+  // Name: ReadInput(Connection&)
+  // Desc: Reads until the socket is drained or the buffer is full
+  void ReadInput(Connection& connection);
+  // Name: HandleRequests(Connection&)
+  // Desc: Answers every complete request line in the input buffer;
+  //   returns true if it stopped at SERVER_OUTPUT_LIMIT with some left
+  bool HandleRequests(Connection& connection);
+  // Name: WriteOutput(Connection&)
+  // Desc: Sends answers until the socket is full or nothing is left
+  void WriteOutput(Connection& connection);
+  // Name: Update(Connection&)
+  // Desc: Closes a finished connection, or sets what epoll waits for
+  void Update(Connection& connection);
+  // Name: Fail(string)
+  // Desc: Sets m_error from errno and returns false
+  bool Fail(const string& what);
+  // Name: Stop(int)
+  // Desc: SIGINT/SIGTERM handler; wakes the loop through s_wake
+  static void Stop(int signal);
+  static int s_wake; //m_wake of the serving server (-1 if none)
+  RouteServer(const RouteServer&); //Not copyable
+  RouteServer& operator=(const RouteServer&); //Not assignable
+  ostream m_nowhere; //BatchDriver's stream (answers go to connections)
+  BatchDriver m_driver; //Parses and runs each request
+  string m_path; //Socket file
+  string m_error; //Why Listen or Serve failed
+  int m_listen; //Listening socket
+  int m_epoll; //epoll instance
+  int m_wake; //eventfd written by the signal handler
+  long m_connectionCount; //Connections accepted
+  long m_requestCount; //Requests answered
+  unordered_map<int, unique_ptr<Connection> > m_connections; //Clients by fd
+};
+
+#endif
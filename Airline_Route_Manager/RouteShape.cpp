@@ -0,0 +1,189 @@
+#include "RouteShape.h"
+#include "Haversine.h"
+
+#include <charconv>
+#include <cmath>
+
+RouteShape::RouteShape(const AirportCatalog& catalog) : m_catalog(catalog) {
+}
+
+int RouteShape::LegSteps(int from, int to, const ShapeSpacing& spacing) const {
+    double steps = 1;
+    if (spacing.points >= 2) {
+        steps = spacing.points - 1;
+    } else if (spacing.maxSegment > 0) {
+        double miles = Haversine(m_catalog.GetNorth(from), m_catalog.GetWest(from),
+                                 m_catalog.GetNorth(to), m_catalog.GetWest(to));
+        steps = ceil(miles / spacing.maxSegment);
+    }
+    if (steps < 1) {
+        return 1;
+    }
+    return steps > SHAPE_MAX_STEPS ? SHAPE_MAX_STEPS : static_cast<int>(steps);
+}
+
+long RouteShape::CountPoints(const vector<int>& stops, const ShapeSpacing& spacing) const {
+    if (stops.empty()) {
+        return 0;
+    }
+    long points = 1;
+    for (int i = 0; i + 1 < static_cast<int>(stops.size()); i++) {
+        points += LegSteps(stops[i], stops[i + 1], spacing);
+    }
+    return points;
+}
+
+void RouteShape::Start(const vector<int>& stops, const ShapeSpacing& spacing, Cursor& cursor) const {
+    cursor.leg = 0;
+    cursor.point = 0;
+    cursor.steps = stops.size() > 1 ? LegSteps(stops[0], stops[1], spacing) : 0;
+    cursor.lastWest = stops.empty() ? 0.0 : m_catalog.GetWest(stops[0]);
+}
+
+long RouteShape::Next(const vector<int>& stops, const ShapeSpacing& spacing, Cursor& cursor,
+                      double* norths, double* wests, long capacity) const {
+    int legs = static_cast<int>(stops.size()) - 1;
+    long written = 0;
+    if (legs == 0 && cursor.point == 0 && capacity > 0) {
+        // A single stop is a single point
+        norths[0] = m_catalog.GetNorth(stops[0]);
+        wests[0] = m_catalog.GetWest(stops[0]);
+        cursor.point = 1;
+        return 1;
+    }
+    while (written < capacity && cursor.leg < legs) {
+        if (cursor.point > cursor.steps) {
+            // Next leg; its first point is the last one of this leg
+            cursor.leg++;
+            if (cursor.leg < legs) {
+                cursor.steps = LegSteps(stops[cursor.leg], stops[cursor.leg + 1], spacing);
+                cursor.point = 1;
+            }
+            continue;
+        }
+        long count = cursor.steps + 1 - cursor.point;
+        if (count > capacity - written) {
+            count = capacity - written;
+        }
+        int from = stops[cursor.leg];
+        int to = stops[cursor.leg + 1];
+        GreatCirclePoints(m_catalog.GetNorth(from), m_catalog.GetWest(from),
+                          m_catalog.GetNorth(to), m_catalog.GetWest(to), cursor.steps,
+                          cursor.point, static_cast<int>(count), norths + written, wests + written);
+        cursor.point += static_cast<int>(count);
+        written += count;
+    }
+    // Keep each longitude within 180 degrees of the one before
+    for (long i = 0; i < written; i++) {
+        wests[i] += 360.0 * nearbyint((cursor.lastWest - wests[i]) / 360.0);
+        cursor.lastWest = wests[i];
+    }
+    return written;
+}
+
+long RouteShape::Densify(const vector<int>& stops, const ShapeSpacing& spacing,
+                         double* norths, double* wests, long capacity) const {
+    Cursor cursor;
+    Start(stops, spacing, cursor);
+    return Next(stops, spacing, cursor, norths, wests, capacity);
+}
+
+void RouteShape::WriteGeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+                              const string& name, ostream& out) {
+    m_text.clear();
+    GeoJSON(stops, spacing, name, m_text, &out);
+}
+
+void RouteShape::AppendGeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+                               const string& name, string& text) {
+    GeoJSON(stops, spacing, name, text, nullptr);
+}
+
+void RouteShape::WritePolyline(const vector<int>& stops, const ShapeSpacing& spacing, ostream& out) {
+    m_text.clear();
+    Polyline(stops, spacing, m_text, &out);
+}
+
+void RouteShape::AppendPolyline(const vector<int>& stops, const ShapeSpacing& spacing, string& text) {
+    Polyline(stops, spacing, text, nullptr);
+}
+
+void RouteShape::GeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+                         const string& name, string& text, ostream* out) {
+    text += "{\"type\":\"Feature\",\"properties\":{\"name\":\"";
+    for (size_t i = 0; i < name.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(name[i]);
+        if (c == '"' || c == '\\') {
+            text += '\\';
+            text += static_cast<char>(c);
+        } else if (c >= 0x20) {
+            text += static_cast<char>(c);
+        }
+    }
+    text += "\"},\"geometry\":{\"type\":\"LineString\",\"coordinates\":[";
+    m_norths.resize(SHAPE_BLOCK_POINTS);
+    m_wests.resize(SHAPE_BLOCK_POINTS);
+    Cursor cursor;
+    Start(stops, spacing, cursor);
+    bool first = true;
+    long count;
+    while ((count = Next(stops, spacing, cursor, m_norths.data(), m_wests.data(), SHAPE_BLOCK_POINTS)) > 0) {
+        for (long i = 0; i < count; i++) {
+            text += first ? "[" : ",[";
+            AppendCoordinate(m_wests[i], text);
+            text += ',';
+            AppendCoordinate(m_norths[i], text);
+            text += ']';
+            first = false;
+        }
+        Flush(text, out, false);
+    }
+    text += "]}}";
+    Flush(text, out, true);
+}
+
+void RouteShape::Polyline(const vector<int>& stops, const ShapeSpacing& spacing,
+                          string& text, ostream* out) {
+    m_norths.resize(SHAPE_BLOCK_POINTS);
+    m_wests.resize(SHAPE_BLOCK_POINTS);
+    Cursor cursor;
+    Start(stops, spacing, cursor);
+    long lastNorth = 0;
+    long lastWest = 0;
+    long count;
+    while ((count = Next(stops, spacing, cursor, m_norths.data(), m_wests.data(), SHAPE_BLOCK_POINTS)) > 0) {
+        for (long i = 0; i < count; i++) {
+            long north = lround(m_norths[i] * SHAPE_POLYLINE_SCALE);
+            long west = lround(m_wests[i] * SHAPE_POLYLINE_SCALE);
+            AppendDelta(north - lastNorth, text);
+            AppendDelta(west - lastWest, text);
+            lastNorth = north;
+            lastWest = west;
+        }
+        Flush(text, out, false);
+    }
+    Flush(text, out, true);
+}
+
+void RouteShape::AppendCoordinate(double value, string& text) {
+    char digits[32];
+    char* end = to_chars(digits, digits + sizeof(digits), value, chars_format::fixed, SHAPE_DIGITS).ptr;
+    text.append(digits, end - digits);
+}
+
+void RouteShape::AppendDelta(long delta, string& text) {
+    unsigned long value = delta < 0 ? ~(static_cast<unsigned long>(delta) << 1)
+                                    : static_cast<unsigned long>(delta) << 1;
+    while (value >= 0x20) {
+        text += static_cast<char>((0x20 | (value & 0x1f)) + 63);
+        value >>= 5;
+    }
+    text += static_cast<char>(value + 63);
+}
+
+void RouteShape::Flush(string& text, ostream* out, bool force) {
+    if (out != nullptr && (force || text.size() >= SHAPE_FLUSH_BYTES)) {
+        out->write(text.data(), text.size());
+        text.clear();
+    }
+}
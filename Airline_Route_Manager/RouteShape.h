@@ -0,0 +1,125 @@
+//Name: RouteShape.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the RouteShape class
+//      Map geometry for routes. Each leg is densified into waypoints along
+//      its great circle, either at most maxSegment miles apart or a fixed
+//      number of points per leg, using GreatCirclePoints (vectorized
+//      slerp). Points go straight into a caller's buffer, or are streamed
+//      a block at a time as a GeoJSON LineString Feature or an encoded
+//      polyline, so a route of any length needs only SHAPE_BLOCK_POINTS
+//      points of memory. The text can also be appended to a caller's
+//      string instead of a stream.
+//      Longitudes are kept continuous along the route (they may go past
+//      +-180) so a line over the antimeridian does not jump across the map.
+
+#ifndef ROUTESHAPE_H
+#define ROUTESHAPE_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+
+#include "AirportCatalog.h"
+using namespace std;
+
+//Constants
+const int SHAPE_BLOCK_POINTS = 1024; //Points densified at a time when streaming
+const int SHAPE_MAX_STEPS = 1 << 20; //Most segments in one leg
+const size_t SHAPE_FLUSH_BYTES = 1 << 16; //Text held before writing it out
+const int SHAPE_DIGITS = 6; //Decimals of each GeoJSON coordinate
+const double SHAPE_POLYLINE_SCALE = 1e5; //Encoded polyline precision
+
+//How densely each leg is sampled
+struct ShapeSpacing {
+  double maxSegment; //Most miles between neighbouring points (if points < 2)
+  int points; //Points per leg including both ends (used if >= 2)
+};
+
+class RouteShape {
+ public:
+  // Name: RouteShape(AirportCatalog&)
+  // Desc: Builds a shape writer for airports in catalog
+  // Preconditions: catalog outlives the writer
+  // Postconditions: Ready to densify routes
+  RouteShape(const AirportCatalog& catalog);
+  // Name: LegSteps(int, int, ShapeSpacing&)
+  // Desc: Segments the leg from one airport to another is split into
+  //   (points - 1, else enough that none is longer than maxSegment, else 1)
+  // Preconditions: Both ids are valid
+  // Postconditions: Returns 1 to SHAPE_MAX_STEPS
+  int LegSteps(int from, int to, const ShapeSpacing& spacing) const;
+  // Name: CountPoints(vector<int>&, ShapeSpacing&)
+  // Desc: Points in the densified route (a stop shared by two legs once)
+  // Preconditions: Every id is valid
+  // Postconditions: Returns the count
+  long CountPoints(const vector<int>& stops, const ShapeSpacing& spacing) const;
+  // Name: Densify(vector<int>&, ShapeSpacing&, double*, double*, long)
+  // Desc: Writes the first capacity points of the densified route to
+  //   norths and wests without allocating
+  // Preconditions: Every id is valid; both arrays hold capacity entries
+  // Postconditions: Returns the points written (CountPoints if it fits)
+  long Densify(const vector<int>& stops, const ShapeSpacing& spacing,
+               double* norths, double* wests, long capacity) const;
+  // Name: WriteGeoJSON(vector<int>&, ShapeSpacing&, string&, ostream&)
+  // Desc: Streams a GeoJSON Feature with a LineString of the densified
+  //   route ([west, north] pairs) and the route name as a property
+  // Preconditions: Every id is valid
+  // Postconditions: One JSON object (no newline) is written to out
+  void WriteGeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+                    const string& name, ostream& out);
+  // Name: WritePolyline(vector<int>&, ShapeSpacing&, ostream&)
+  // Desc: Streams the densified route in the encoded polyline format
+  //   (delta and zigzag coded north/west pairs at 5 decimals, 5 bits per
+  //   printable character)
+  // Preconditions: Every id is valid
+  // Postconditions: The polyline (no newline) is written to out
+  void WritePolyline(const vector<int>& stops, const ShapeSpacing& spacing, ostream& out);
+  // Name: AppendGeoJSON / AppendPolyline
+  // Desc: As WriteGeoJSON and WritePolyline, but append the text to the
+  //   end of a caller's buffer (a batch answer) instead of a stream
+  // Preconditions: Every id is valid
+  // Postconditions: The text (no newline) is appended to text
+  void AppendGeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+                     const string& name, string& text);
+  void AppendPolyline(const vector<int>& stops, const ShapeSpacing& spacing, string& text);
+ private:
+  //Position in a route being densified
+  struct Cursor {
+    int leg; //Leg being densified (stops[leg] -> stops[leg + 1])
+    int point; //Next point of that leg
+    int steps; //Segments in that leg
+    double lastWest; //Longitude of the last point written
+  };
+  // Name: Start(vector<int>&, ShapeSpacing&, Cursor&)
+  // Desc: Moves the cursor to the first point of the route
+  void Start(const vector<int>& stops, const ShapeSpacing& spacing, Cursor& cursor) const;
+  // Name: Next(vector<int>&, ShapeSpacing&, Cursor&, double*, double*, long)
+  // Desc: Writes up to capacity points from the cursor on and advances it
+  //   (returns 0 at the end of the route)
+  long Next(const vector<int>& stops, const ShapeSpacing& spacing, Cursor& cursor,
+            double* norths, double* wests, long capacity) const;
+  // Name: GeoJSON / Polyline
+  // Desc: Append the route to text, writing text out to out (and
+  //   clearing it) every SHAPE_FLUSH_BYTES if out is not nullptr
+  void GeoJSON(const vector<int>& stops, const ShapeSpacing& spacing,
+               const string& name, string& text, ostream* out);
+  void Polyline(const vector<int>& stops, const ShapeSpacing& spacing,
+                string& text, ostream* out);
+  // Name: AppendCoordinate(double, string&)
+  // Desc: Appends a number with SHAPE_DIGITS decimals to text
+  void AppendCoordinate(double value, string& text);
+  // Name: AppendDelta(long, string&)
+  // Desc: Appends one zigzag coded polyline delta to text
+  void AppendDelta(long delta, string& text);
+  // Name: Flush(string&, ostream*, bool)
+  // Desc: Writes text to out once it holds SHAPE_FLUSH_BYTES (or always);
+  //   does nothing if out is nullptr
+  void Flush(string& text, ostream* out, bool force);
+  const AirportCatalog& m_catalog; //Airport coordinates
+  vector<double> m_norths; //Block of points being streamed
+  vector<double> m_wests;
+  string m_text; //Text not yet written to a stream
+};
+
+#endif
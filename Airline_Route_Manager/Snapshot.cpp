@@ -0,0 +1,442 @@
+#include "Snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Constants
+const uint64_t SNAPSHOT_ALIGN = 64; //Every section starts on a cache line
+
+//Section ids; each appears at most once in a snapshot
+enum SectionID {
+    SECTION_STRING_TEXT,
+    SECTION_STRING_OFFSETS,
+    SECTION_STRING_SLOTS,
+    SECTION_CODES,
+    SECTION_NAMES,
+    SECTION_CITIES,
+    SECTION_COUNTRIES,
+    SECTION_NORTHS,
+    SECTION_WESTS,
+    SECTION_CODE_SLOTS,
+    SECTION_CACHE_MATRIX,
+    SECTION_TREE_NODES,
+    SECTION_TREE_X,
+    SECTION_TREE_Y,
+    SECTION_TREE_Z,
+    SECTION_TREE_IDS,
+    SECTION_ROUTE_OFFSETS,
+    SECTION_ROUTE_IDS,
+    SECTION_COUNT
+};
+
+namespace {
+
+//Data for one section while saving
+struct Pending {
+    uint32_t id;
+    uint32_t elementSize;
+    const void* data;
+    uint64_t size;
+};
+
+template <typename T>
+Pending MakePending(uint32_t id, const T* data, size_t count) {
+    Pending pending = {id, static_cast<uint32_t>(sizeof(T)), data, count * sizeof(T)};
+    return pending;
+}
+
+uint64_t Rotate(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t AlignUp(uint64_t value) {
+    return (value + SNAPSHOT_ALIGN - 1) & ~(SNAPSHOT_ALIGN - 1);
+}
+
+}
+
+Snapshot::Snapshot() {
+    m_mapping = nullptr;
+    m_size = 0;
+}
+
+Snapshot::~Snapshot() {
+    Unmap();
+}
+
+void Snapshot::Unmap() {
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_size);
+    }
+    m_mapping = nullptr;
+    m_size = 0;
+}
+
+bool Snapshot::IsMapped() const {
+    return m_mapping != nullptr;
+}
+
+string Snapshot::GetError() const {
+    return m_error;
+}
+
+uint64_t Snapshot::Checksum(const void* data, size_t size) {
+    const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    // Four independent lanes so the multiplies overlap
+    uint64_t lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; lane++) {
+            uint64_t word;
+            memcpy(&word, bytes + i + 8 * lane, sizeof(word));
+            lanes[lane] = Rotate(lanes[lane] + word * PRIME2, 31) * PRIME1;
+        }
+    }
+    uint64_t hash = size * PRIME1;
+    for (int lane = 0; lane < 4; lane++) {
+        hash = Rotate(hash ^ lanes[lane], 27) * PRIME1 + PRIME2;
+    }
+    for (; i < size; i++) {
+        hash = Rotate(hash ^ (bytes[i] * PRIME2), 23) * PRIME1;
+    }
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+bool Snapshot::SourceInfo(const string& fileName, uint64_t& size, int64_t& time) {
+    struct stat info;
+    if (stat(fileName.c_str(), &info) != 0) {
+        return false;
+    }
+    size = static_cast<uint64_t>(info.st_size);
+    time = static_cast<int64_t>(info.st_mtime);
+    return true;
+}
+
+bool Snapshot::Save(const string& fileName, const string& sourceFile,
+                    const AirportCatalog& catalog, const DistanceCache& cache,
+                    const SpatialIndex& index, const vector<Route*>& routes) {
+    // Routes are stored as one offset per route into a shared id array
+    vector<uint32_t> routeOffsets(1, 0);
+    vector<uint32_t> routeIDs;
+    for (int i = 0; i < static_cast<int>(routes.size()); i++) {
+        int size = routes[i]->GetSize();
+        bool valid = true;
+        for (int j = 0; j < size && valid; j++) {
+            valid = routes[i]->GetID(j) >= 0;
+        }
+        // Routes of airports outside the catalog cannot be restored
+        if (!valid) {
+            continue;
+        }
+        for (int j = 0; j < size; j++) {
+            routeIDs.push_back(static_cast<uint32_t>(routes[i]->GetID(j)));
+        }
+        routeOffsets.push_back(static_cast<uint32_t>(routeIDs.size()));
+    }
+
+    const StringTable& strings = catalog.m_strings;
+    int airports = catalog.GetSize();
+    vector<Pending> sections;
+    sections.push_back(MakePending(SECTION_STRING_TEXT, strings.m_text.data(), strings.m_text.size()));
+    sections.push_back(MakePending(SECTION_STRING_OFFSETS, strings.m_offsets.data(), strings.m_offsets.size()));
+    sections.push_back(MakePending(SECTION_STRING_SLOTS, strings.m_slots.data(), strings.m_slots.size()));
+    sections.push_back(MakePending(SECTION_CODES, catalog.m_codes.data(), catalog.m_codes.size()));
+    sections.push_back(MakePending(SECTION_NAMES, catalog.m_names.data(), catalog.m_names.size()));
+    sections.push_back(MakePending(SECTION_CITIES, catalog.m_cities.data(), catalog.m_cities.size()));
+    sections.push_back(MakePending(SECTION_COUNTRIES, catalog.m_countries.data(), catalog.m_countries.size()));
+    sections.push_back(MakePending(SECTION_NORTHS, catalog.m_norths.data(), catalog.m_norths.size()));
+    sections.push_back(MakePending(SECTION_WESTS, catalog.m_wests.data(), catalog.m_wests.size()));
+    sections.push_back(MakePending(SECTION_CODE_SLOTS, catalog.m_codeSlots.data(), catalog.m_codeSlots.size()));
+    // The cache is only saved if it matches the catalog
+    if (cache.IsBuilt() && cache.GetSize() == airports) {
+        sections.push_back(MakePending(SECTION_CACHE_MATRIX, cache.m_matrix, cache.GetEntryCount()));
+    }
+    if (static_cast<int>(index.m_ids.size()) == airports) {
+        sections.push_back(MakePending(SECTION_TREE_NODES, index.m_nodes.data(), index.m_nodes.size()));
+        sections.push_back(MakePending(SECTION_TREE_X, index.m_x.data(), index.m_x.size()));
+        sections.push_back(MakePending(SECTION_TREE_Y, index.m_y.data(), index.m_y.size()));
+        sections.push_back(MakePending(SECTION_TREE_Z, index.m_z.data(), index.m_z.size()));
+        sections.push_back(MakePending(SECTION_TREE_IDS, index.m_ids.data(), index.m_ids.size()));
+    }
+    sections.push_back(MakePending(SECTION_ROUTE_OFFSETS, routeOffsets.data(), routeOffsets.size()));
+    sections.push_back(MakePending(SECTION_ROUTE_IDS, routeIDs.data(), routeIDs.size()));
+
+    // Lay out the table and every section on aligned offsets
+    vector<Section> table(sections.size());
+    uint64_t offset = AlignUp(sizeof(Header) + table.size() * sizeof(Section));
+    for (int i = 0; i < static_cast<int>(sections.size()); i++) {
+        table[i].id = sections[i].id;
+        table[i].elementSize = sections[i].elementSize;
+        table[i].offset = offset;
+        table[i].size = sections[i].size;
+        table[i].checksum = Checksum(sections[i].data, sections[i].size);
+        offset = AlignUp(offset + sections[i].size);
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = static_cast<uint32_t>(table.size());
+    header.fileSize = offset;
+    header.tableChecksum = Checksum(table.data(), table.size() * sizeof(Section));
+    SourceInfo(sourceFile, header.sourceSize, header.sourceTime);
+
+    // Written beside the target and renamed so readers never see half a file
+    string tempName = fileName + ".tmp";
+    ofstream out(tempName.c_str(), ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        m_error = "cannot create " + tempName;
+        return false;
+    }
+    const char padding[SNAPSHOT_ALIGN] = {0};
+    uint64_t written = sizeof(Header) + table.size() * sizeof(Section);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Section));
+    for (int i = 0; i < static_cast<int>(sections.size()); i++) {
+        out.write(padding, table[i].offset - written);
+        out.write(static_cast<const char*>(sections[i].data), sections[i].size);
+        written = table[i].offset + sections[i].size;
+    }
+    out.write(padding, header.fileSize - written);
+    out.close();
+    if (!out) {
+        remove(tempName.c_str());
+        m_error = "cannot write " + tempName;
+        return false;
+    }
+    if (rename(tempName.c_str(), fileName.c_str()) != 0) {
+        remove(tempName.c_str());
+        m_error = "cannot replace " + fileName;
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::Load(const string& fileName, const string& sourceFile,
+                    AirportCatalog& catalog, DistanceCache& cache,
+                    SpatialIndex& index, vector<vector<int> >& routes) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        m_error = "cannot open " + fileName;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        m_error = "file too small";
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        m_error = "cannot map " + fileName;
+        return false;
+    }
+    const char* base = static_cast<const char*>(mapping);
+
+    // Everything is checked before anything is attached
+    m_error = "";
+    Header header;
+    memcpy(&header, base, sizeof(header));
+    const Section* table = reinterpret_cast<const Section*>(base + sizeof(Header));
+    const Section* found[SECTION_COUNT] = {nullptr};
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        m_error = "not a snapshot";
+    } else if (header.version != SNAPSHOT_VERSION) {
+        m_error = "unsupported version " + to_string(header.version);
+    } else if (header.fileSize != size ||
+               header.sectionCount > (size - sizeof(Header)) / sizeof(Section)) {
+        m_error = "truncated";
+    } else if (Checksum(table, header.sectionCount * sizeof(Section)) != header.tableChecksum) {
+        m_error = "section table checksum mismatch";
+    } else if (SourceInfo(sourceFile, sourceSize, sourceTime) &&
+               (sourceSize != header.sourceSize || sourceTime != header.sourceTime)) {
+        m_error = sourceFile + " changed since the snapshot was saved";
+    }
+    for (uint32_t i = 0; i < header.sectionCount && m_error.empty(); i++) {
+        const Section& section = table[i];
+        if (section.id >= SECTION_COUNT || found[section.id] != nullptr ||
+            section.offset % SNAPSHOT_ALIGN != 0 || section.offset > size ||
+            section.size > size - section.offset || section.elementSize == 0 ||
+            section.size % section.elementSize != 0) {
+            m_error = "bad section " + to_string(i);
+        } else if (Checksum(base + section.offset, section.size) != section.checksum) {
+            m_error = "checksum mismatch in section " + to_string(i);
+        } else {
+            found[section.id] = &section;
+        }
+    }
+
+    // Section contents and counts (0 if missing or the wrong element size)
+    const void* data[SECTION_COUNT] = {nullptr};
+    size_t count[SECTION_COUNT] = {0};
+    const uint32_t elementSizes[SECTION_COUNT] = {
+        sizeof(char), sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t),
+        sizeof(uint32_t), sizeof(uint32_t), sizeof(uint32_t), sizeof(double),
+        sizeof(double), sizeof(int), sizeof(double), sizeof(SpatialIndex::Node),
+        sizeof(double), sizeof(double), sizeof(double), sizeof(int),
+        sizeof(uint32_t), sizeof(uint32_t)};
+    for (int id = 0; id < SECTION_COUNT && m_error.empty(); id++) {
+        if (found[id] == nullptr) {
+            continue;
+        }
+        if (found[id]->elementSize != elementSizes[id]) {
+            m_error = "bad element size in section " + to_string(id);
+        }
+        data[id] = base + found[id]->offset;
+        count[id] = found[id]->size / elementSizes[id];
+    }
+
+    // Counts must agree with each other so no lookup can leave a column
+    const uint32_t* stringOffsets = static_cast<const uint32_t*>(data[SECTION_STRING_OFFSETS]);
+    const uint32_t* stringSlots = static_cast<const uint32_t*>(data[SECTION_STRING_SLOTS]);
+    size_t stringCount = count[SECTION_STRING_OFFSETS] - 1;
+    size_t slotCount = count[SECTION_STRING_SLOTS];
+    size_t airports = count[SECTION_CODES];
+    if (m_error.empty()) {
+        if (count[SECTION_STRING_OFFSETS] == 0 || stringOffsets[0] != 0 ||
+            stringOffsets[stringCount] != count[SECTION_STRING_TEXT] ||
+            slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || 2 * stringCount > slotCount) {
+            m_error = "bad string table";
+        }
+        for (size_t i = 0; i < stringCount && m_error.empty(); i++) {
+            if (stringOffsets[i] > stringOffsets[i + 1]) {
+                m_error = "bad string table";
+            }
+        }
+        for (size_t i = 0; i < slotCount && m_error.empty(); i++) {
+            if (stringSlots[i] > stringCount) {
+                m_error = "bad string table";
+            }
+        }
+    }
+    if (m_error.empty()) {
+        if (count[SECTION_NAMES] != airports || count[SECTION_CITIES] != airports ||
+            count[SECTION_COUNTRIES] != airports || count[SECTION_NORTHS] != airports ||
+            count[SECTION_WESTS] != airports || count[SECTION_CODE_SLOTS] != (size_t)CODE_SLOTS) {
+            m_error = "bad airport columns";
+        }
+        for (int id = SECTION_CODES; id <= SECTION_COUNTRIES && m_error.empty(); id++) {
+            const uint32_t* column = static_cast<const uint32_t*>(data[id]);
+            for (size_t i = 0; i < airports && m_error.empty(); i++) {
+                if (column[i] >= stringCount) {
+                    m_error = "bad airport columns";
+                }
+            }
+        }
+        const int* codeSlots = static_cast<const int*>(data[SECTION_CODE_SLOTS]);
+        for (size_t i = 0; i < count[SECTION_CODE_SLOTS] && m_error.empty(); i++) {
+            if (codeSlots[i] < -1 || codeSlots[i] >= static_cast<int>(airports)) {
+                m_error = "bad airport columns";
+            }
+        }
+    }
+    bool hasCache = found[SECTION_CACHE_MATRIX] != nullptr;
+    if (m_error.empty() && hasCache && count[SECTION_CACHE_MATRIX] != airports * (airports - 1) / 2) {
+        m_error = "bad distance cache";
+    }
+    bool hasTree = found[SECTION_TREE_IDS] != nullptr;
+    if (m_error.empty() && hasTree) {
+        size_t nodeCount = count[SECTION_TREE_NODES];
+        if (count[SECTION_TREE_IDS] != airports || count[SECTION_TREE_X] != airports ||
+            count[SECTION_TREE_Y] != airports || count[SECTION_TREE_Z] != airports ||
+            (airports > 0 && nodeCount == 0)) {
+            m_error = "bad spatial index";
+        }
+        const SpatialIndex::Node* nodes = static_cast<const SpatialIndex::Node*>(data[SECTION_TREE_NODES]);
+        for (size_t i = 0; i < nodeCount && m_error.empty(); i++) {
+            const SpatialIndex::Node& node = nodes[i];
+            // Children always come after their parent, so the tree has no cycles
+            bool leaf = node.left < 0 && node.right < 0;
+            bool inner = node.left > static_cast<int>(i) && node.right > static_cast<int>(i) &&
+                node.left < static_cast<int>(nodeCount) && node.right < static_cast<int>(nodeCount) &&
+                node.axis >= 0 && node.axis < 3;
+            if (node.begin < 0 || node.begin > node.end || node.end > static_cast<int>(airports) ||
+                !(leaf || inner)) {
+                m_error = "bad spatial index";
+            }
+        }
+        const int* treeIDs = static_cast<const int*>(data[SECTION_TREE_IDS]);
+        for (size_t i = 0; i < airports && m_error.empty(); i++) {
+            if (treeIDs[i] < 0 || treeIDs[i] >= static_cast<int>(airports)) {
+                m_error = "bad spatial index";
+            }
+        }
+    }
+    const uint32_t* routeOffsets = static_cast<const uint32_t*>(data[SECTION_ROUTE_OFFSETS]);
+    const uint32_t* routeIDs = static_cast<const uint32_t*>(data[SECTION_ROUTE_IDS]);
+    if (m_error.empty()) {
+        size_t routeCount = count[SECTION_ROUTE_OFFSETS];
+        if (routeCount == 0 || routeOffsets[0] != 0 ||
+            routeOffsets[routeCount - 1] != count[SECTION_ROUTE_IDS]) {
+            m_error = "bad routes";
+        }
+        for (size_t i = 0; i + 1 < routeCount && m_error.empty(); i++) {
+            if (routeOffsets[i] > routeOffsets[i + 1]) {
+                m_error = "bad routes";
+            }
+        }
+        for (size_t i = 0; i < count[SECTION_ROUTE_IDS] && m_error.empty(); i++) {
+            if (routeIDs[i] >= airports) {
+                m_error = "bad routes";
+            }
+        }
+    }
+    if (!m_error.empty()) {
+        munmap(mapping, size);
+        return false;
+    }
+
+    // Verified: point the catalog, cache and index at the mapping
+    catalog.Clear();
+    cache.Clear();
+    catalog.m_strings.m_text.Attach(static_cast<const char*>(data[SECTION_STRING_TEXT]), count[SECTION_STRING_TEXT]);
+    catalog.m_strings.m_offsets.Attach(stringOffsets, count[SECTION_STRING_OFFSETS]);
+    catalog.m_strings.m_slots.Attach(stringSlots, slotCount);
+    catalog.m_codes.Attach(static_cast<const uint32_t*>(data[SECTION_CODES]), airports);
+    catalog.m_names.Attach(static_cast<const uint32_t*>(data[SECTION_NAMES]), airports);
+    catalog.m_cities.Attach(static_cast<const uint32_t*>(data[SECTION_CITIES]), airports);
+    catalog.m_countries.Attach(static_cast<const uint32_t*>(data[SECTION_COUNTRIES]), airports);
+    catalog.m_norths.Attach(static_cast<const double*>(data[SECTION_NORTHS]), airports);
+    catalog.m_wests.Attach(static_cast<const double*>(data[SECTION_WESTS]), airports);
+    catalog.m_codeSlots.Attach(static_cast<const int*>(data[SECTION_CODE_SLOTS]), count[SECTION_CODE_SLOTS]);
+    catalog.RebuildOtherCodes();
+    if (hasCache) {
+        cache.Attach(static_cast<const double*>(data[SECTION_CACHE_MATRIX]), static_cast<int>(airports));
+    }
+    if (hasTree) {
+        index.m_nodes.Attach(static_cast<const SpatialIndex::Node*>(data[SECTION_TREE_NODES]), count[SECTION_TREE_NODES]);
+        index.m_x.Attach(static_cast<const double*>(data[SECTION_TREE_X]), airports);
+        index.m_y.Attach(static_cast<const double*>(data[SECTION_TREE_Y]), airports);
+        index.m_z.Attach(static_cast<const double*>(data[SECTION_TREE_Z]), airports);
+        index.m_ids.Attach(static_cast<const int*>(data[SECTION_TREE_IDS]), airports);
+        index.m_catalog = &catalog;
+    } else {
+        index.Build(catalog);
+    }
+    routes.clear();
+    for (size_t i = 0; i + 1 < count[SECTION_ROUTE_OFFSETS]; i++) {
+        routes.push_back(vector<int>(routeIDs + routeOffsets[i], routeIDs + routeOffsets[i + 1]));
+    }
+
+    // The previous mapping is no longer referenced
+    Unmap();
+    m_mapping = mapping;
+    m_size = size;
+    return true;
+}
@@ -0,0 +1,106 @@
+//Name: Snapshot.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the Snapshot class
+//      A snapshot is a versioned binary file holding the airport catalog,
+//      its interned strings, the distance cache, the spatial index and
+//      every route. Loading memory-maps the file and points the catalog,
+//      cache and index straight at the mapped sections (nothing is parsed
+//      or copied). Every section carries a checksum that is verified
+//      before anything is attached.
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "AirportCatalog.h"
+#include "DistanceCache.h"
+#include "SpatialIndex.h"
+#include "Route.h"
+using namespace std;
+
+//Constants
+const char SNAPSHOT_MAGIC[8] = {'A', 'R', 'M', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t SNAPSHOT_VERSION = 2; //Bump when the layout changes
+const string SNAPSHOT_EXTENSION = ".snap"; //Appended to the airport file name
+
+class Snapshot {
+ public:
+  // Name: Snapshot() - Default Constructor
+  // Desc: Builds a snapshot with nothing mapped
+  // Preconditions: None
+  // Postconditions: IsMapped is false
+  Snapshot();
+  // Name: ~Snapshot() - Destructor
+  // Desc: Unmaps the file
+  // Preconditions: Nothing attached to this snapshot is used afterwards
+  // Postconditions: Mapping is released
+  ~Snapshot();
+  // Name: Save(string, string, AirportCatalog&, DistanceCache&, SpatialIndex&, vector<Route*>&)
+  // Desc: Writes a snapshot of the catalog, cache, index and routes.
+  //   sourceFile is the text file the catalog came from; its size and
+  //   modification time are recorded so a stale snapshot is not loaded.
+  //   Written to a temporary file and renamed, so an existing snapshot
+  //   (even one currently mapped) is replaced atomically.
+  //   Routes are saved as their airport ids.
+  // Preconditions: None
+  // Postconditions: Returns false (see GetError) if it could not be written
+  bool Save(const string& fileName, const string& sourceFile,
+            const AirportCatalog& catalog, const DistanceCache& cache,
+            const SpatialIndex& index, const vector<Route*>& routes);
+  // Name: Load(string, string, AirportCatalog&, DistanceCache&, SpatialIndex&, vector<vector<int>>&)
+  // Desc: Maps a snapshot, verifies its version, checksums and section
+  //   sizes, and attaches the catalog, cache and index to the mapping.
+  //   Fails if sourceFile exists and differs from when it was saved.
+  // Preconditions: None
+  // Postconditions: Returns true with routes holding each saved route's
+  //   airport ids; on false nothing passed in is changed
+  bool Load(const string& fileName, const string& sourceFile,
+            AirportCatalog& catalog, DistanceCache& cache,
+            SpatialIndex& index, vector<vector<int> >& routes);
+  // Name: IsMapped()
+  // Preconditions: None
+  // Postconditions: Returns true while a snapshot is mapped
+  bool IsMapped() const;
+  // Name: GetError()
+  // Preconditions: None
+  // Postconditions: Returns why the last Save or Load failed
+  string GetError() const;
+ private:
+  //Fixed-size file header
+  struct Header {
+    char magic[8]; //SNAPSHOT_MAGIC
+    uint32_t version; //SNAPSHOT_VERSION
+    uint32_t sectionCount; //Entries in the section table
+    uint64_t fileSize; //Total bytes in the file
+    uint64_t sourceSize; //Size of the text file when saved
+    int64_t sourceTime; //Modification time of the text file when saved
+    uint64_t tableChecksum; //Checksum of the section table
+  };
+  //One entry of the section table
+  struct Section {
+    uint32_t id; //Which data this is (see Snapshot.cpp)
+    uint32_t elementSize; //Bytes per element
+    uint64_t offset; //Start of the data (64-byte aligned)
+    uint64_t size; //Bytes of data
+    uint64_t checksum; //Checksum of the data
+  };
+  // Name: Checksum(const void*, size_t)
+  // Desc: 64-bit checksum using four multiply-rotate lanes
+  static uint64_t Checksum(const void* data, size_t size);
+  // Name: SourceInfo(string, uint64_t&, int64_t&)
+  // Desc: Size and modification time of a file (false if missing)
+  static bool SourceInfo(const string& fileName, uint64_t& size, int64_t& time);
+  // Name: Unmap()
+  // Desc: Releases the current mapping
+  void Unmap();
+  void *m_mapping; //Mapped file (nullptr if none)
+  size_t m_size; //Bytes mapped
+  string m_error; //Why the last Save or Load failed
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "SpaceSaving.h"
+
+#include <algorithm>
+
+SpaceSaving::SpaceSaving(int capacity) {
+    m_capacity = capacity < 1 ? 1 : capacity;
+    m_heap.reserve(m_capacity);
+    m_positions.reserve(m_capacity);
+}
+
+void SpaceSaving::Swap(int a, int b) {
+    HeavyHitter temp = m_heap[a];
+    m_heap[a] = m_heap[b];
+    m_heap[b] = temp;
+    m_positions[m_heap[a].key] = a;
+    m_positions[m_heap[b].key] = b;
+}
+
+void SpaceSaving::SiftDown(int i) {
+    int size = static_cast<int>(m_heap.size());
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < size && m_heap[left].count < m_heap[smallest].count) {
+            smallest = left;
+        }
+        if (right < size && m_heap[right].count < m_heap[smallest].count) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        Swap(i, smallest);
+        i = smallest;
+    }
+}
+
+void SpaceSaving::SiftUp(int i) {
+    while (i > 0 && m_heap[(i - 1) / 2].count > m_heap[i].count) {
+        Swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void SpaceSaving::Add(uint64_t key, uint64_t count) {
+    unordered_map<uint64_t, int>::iterator found = m_positions.find(key);
+    if (found != m_positions.end()) {
+        // A count only grows, so the entry can only move down
+        int i = found->second;
+        m_heap[i].count += count;
+        SiftDown(i);
+        return;
+    }
+    if (static_cast<int>(m_heap.size()) < m_capacity) {
+        HeavyHitter hitter = {key, count, 0};
+        m_heap.push_back(hitter);
+        int i = static_cast<int>(m_heap.size()) - 1;
+        m_positions[key] = i;
+        SiftUp(i);
+        return;
+    }
+    // Take over the smallest entry; its count is the new key's error
+    HeavyHitter& smallest = m_heap[0];
+    m_positions.erase(smallest.key);
+    smallest.error = smallest.count;
+    smallest.count += count;
+    smallest.key = key;
+    m_positions[key] = 0;
+    SiftDown(0);
+}
+
+void SpaceSaving::Top(int k, vector<HeavyHitter>& top) const {
+    top = m_heap;
+    int keep = k < static_cast<int>(top.size()) ? k : static_cast<int>(top.size());
+    partial_sort(top.begin(), top.begin() + keep, top.end(),
+                 [](const HeavyHitter& a, const HeavyHitter& b) {
+        return a.count != b.count ? a.count > b.count : a.key < b.key;
+    });
+    top.resize(keep);
+}
+
+int SpaceSaving::GetCapacity() const {
+    return m_capacity;
+}
+
+void SpaceSaving::Clear() {
+    m_heap.clear();
+    m_positions.clear();
+}
@@ -0,0 +1,68 @@
+//Name: SpaceSaving.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the SpaceSaving class
+//      Heavy hitters of a stream of 64-bit keys in fixed memory (Metwally,
+//      Agrawal and El Abbadi). At most capacity keys are monitored. A new
+//      key replaces the one with the smallest count and inherits that
+//      count as its error. Any key seen more than total / capacity times
+//      is always monitored, and each count overestimates by at most its
+//      error. Monitored keys sit in a binary min-heap by count, so an add
+//      is O(log capacity).
+
+#ifndef SPACESAVING_H
+#define SPACESAVING_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+//One monitored key
+struct HeavyHitter {
+  uint64_t key; //Key counted
+  uint64_t count; //Upper bound on the key's occurrences
+  uint64_t error; //count - error is a lower bound
+};
+
+class SpaceSaving {
+ public:
+  // Name: SpaceSaving(int) - Overloaded Constructor
+  // Desc: Builds an empty summary monitoring up to capacity keys
+  // Preconditions: capacity >= 1
+  // Postconditions: No keys are monitored
+  SpaceSaving(int capacity);
+  // Name: Add(uint64_t, uint64_t)
+  // Desc: Counts count more occurrences of key
+  // Preconditions: count >= 1
+  // Postconditions: key is monitored
+  void Add(uint64_t key, uint64_t count);
+  // Name: Top(int, vector<HeavyHitter>&)
+  // Desc: The k monitored keys with the highest counts (ties by key)
+  // Preconditions: k >= 0
+  // Postconditions: top holds up to k keys, highest count first
+  void Top(int k, vector<HeavyHitter>& top) const;
+  // Name: GetCapacity()
+  // Preconditions: None
+  // Postconditions: Returns the most keys monitored
+  int GetCapacity() const;
+  // Name: Clear()
+  // Preconditions: None
+  // Postconditions: No keys are monitored
+  void Clear();
+ private:
+  // Name: SiftDown(int)
+  // Desc: Moves m_heap[i] down until both children count at least as much
+  void SiftDown(int i);
+  // Name: SiftUp(int)
+  // Desc: Moves m_heap[i] up until its parent counts no more
+  void SiftUp(int i);
+  // Name: Swap(int, int)
+  // Desc: Swaps two heap entries and updates m_positions
+  void Swap(int a, int b);
+  int m_capacity; //Most keys monitored
+  vector<HeavyHitter> m_heap; //Min-heap by count
+  unordered_map<uint64_t, int> m_positions; //Key -> index in m_heap
+};
+
+#endif
@@ -0,0 +1,255 @@
+#include "SpatialIndex.h"
+#include "Haversine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace {
+
+// Unit vector of a point given in degrees
+void ToUnit(double north, double west, double& x, double& y, double& z) {
+    double lat = north * DEG_2_RAD;
+    double lng = west * DEG_2_RAD;
+    x = cos(lat) * cos(lng);
+    y = cos(lat) * sin(lng);
+    z = sin(lat);
+}
+
+// Squared chord length for a great-circle distance in miles, padded so
+// rounding never drops an airport that the exact check would keep
+double ChordSquared(double miles) {
+    double angle = miles / EARTH_RADIUS;
+    if (angle >= PI) {
+        return 4.0 + 1e-9;
+    }
+    double chord = 2.0 * sin(angle / 2.0);
+    return chord * chord * (1.0 + 1e-9) + 1e-15;
+}
+
+}
+
+SpatialIndex::SpatialIndex() {
+    m_catalog = nullptr;
+}
+
+void SpatialIndex::Build(const AirportCatalog& catalog) {
+    int size = catalog.GetSize();
+    m_catalog = &catalog;
+    vector<Node> nodes;
+    vector<int> ids(size);
+    for (int i = 0; i < size; i++) {
+        ids[i] = i;
+    }
+    vector<double> x(size), y(size), z(size);
+    for (int i = 0; i < size; i++) {
+        ToUnit(catalog.GetNorth(i), catalog.GetWest(i), x[i], y[i], z[i]);
+    }
+
+    // Split ids first, then lay the coordinates out in tree order so each
+    // leaf's points are contiguous
+    if (size > 0) {
+        nodes.reserve(2 * size / KD_LEAF_SIZE + 1);
+        const vector<double>* coords[3] = {&x, &y, &z};
+        BuildNode(nodes, ids, coords, 0, size);
+    }
+    vector<double> treeX(size), treeY(size), treeZ(size);
+    for (int i = 0; i < size; i++) {
+        treeX[i] = x[ids[i]];
+        treeY[i] = y[ids[i]];
+        treeZ[i] = z[ids[i]];
+    }
+    m_nodes.Adopt(nodes);
+    m_ids.Adopt(ids);
+    m_x.Adopt(treeX);
+    m_y.Adopt(treeY);
+    m_z.Adopt(treeZ);
+}
+
+int SpatialIndex::BuildNode(vector<Node>& nodes, vector<int>& ids,
+                            const vector<double>* coords[3], int begin, int end) {
+    int index = static_cast<int>(nodes.size());
+    Node node = {begin, end, -1, -1, 0, 0, 0.0};
+    nodes.push_back(node);
+    if (end - begin <= KD_LEAF_SIZE) {
+        return index;
+    }
+
+    // Split on the axis with the widest spread
+    int axis = 0;
+    double widest = -1.0;
+    for (int a = 0; a < 3; a++) {
+        double low = (*coords[a])[ids[begin]];
+        double high = low;
+        for (int i = begin + 1; i < end; i++) {
+            double value = (*coords[a])[ids[i]];
+            low = min(low, value);
+            high = max(high, value);
+        }
+        if (high - low > widest) {
+            widest = high - low;
+            axis = a;
+        }
+    }
+
+    const vector<double>& values = *coords[axis];
+    int middle = begin + (end - begin) / 2;
+    nth_element(ids.begin() + begin, ids.begin() + middle, ids.begin() + end,
+                [&values](int a, int b) { return values[a] < values[b]; });
+
+    double split = values[ids[middle]];
+    int left = BuildNode(nodes, ids, coords, begin, middle);
+    int right = BuildNode(nodes, ids, coords, middle, end);
+    nodes[index].axis = axis;
+    nodes[index].split = split;
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+bool SpatialIndex::IsBuilt() const {
+    return !m_nodes.empty();
+}
+
+int SpatialIndex::GetSize() const {
+    return static_cast<int>(m_ids.size());
+}
+
+void SpatialIndex::Measure(double north, double west, const vector<int>& ids,
+                           vector<double>& miles) const {
+    int count = static_cast<int>(ids.size());
+    vector<double> norths(count), wests(count);
+    for (int i = 0; i < count; i++) {
+        norths[i] = m_catalog->GetNorth(ids[i]);
+        wests[i] = m_catalog->GetWest(ids[i]);
+    }
+    miles.resize(count);
+    BatchDistanceFrom(north, west, norths.data(), wests.data(), miles.data(), count);
+}
+
+void SpatialIndex::Nearest(double north, double west, int k, vector<int>& ids,
+                           vector<double>& miles, int exclude) const {
+    ids.clear();
+    miles.clear();
+    if (m_nodes.empty() || k <= 0) {
+        return;
+    }
+    double query[3];
+    ToUnit(north, west, query[0], query[1], query[2]);
+
+    // Max-heap of the best k so far by squared chord
+    priority_queue<pair<double, int> > best;
+    // Depth-first with an explicit stack of (node, squared distance to
+    // the splitting plane that had to be crossed to reach it)
+    vector<pair<int, double> > stack;
+    stack.push_back(make_pair(0, 0.0));
+    while (!stack.empty()) {
+        int index = stack.back().first;
+        double planeDistance = stack.back().second;
+        stack.pop_back();
+        if (static_cast<int>(best.size()) == k && planeDistance > best.top().first) {
+            continue;
+        }
+        const Node& node = m_nodes[index];
+        if (node.left == -1) {
+            for (int i = node.begin; i < node.end; i++) {
+                if (m_ids[i] == exclude) {
+                    continue;
+                }
+                double dx = m_x[i] - query[0];
+                double dy = m_y[i] - query[1];
+                double dz = m_z[i] - query[2];
+                double chord = dx * dx + dy * dy + dz * dz;
+                if (static_cast<int>(best.size()) < k) {
+                    best.push(make_pair(chord, m_ids[i]));
+                } else if (chord < best.top().first) {
+                    best.pop();
+                    best.push(make_pair(chord, m_ids[i]));
+                }
+            }
+            continue;
+        }
+        double offset = query[node.axis] - node.split;
+        int nearChild = offset < 0 ? node.left : node.right;
+        int farChild = offset < 0 ? node.right : node.left;
+        // Far side pushed first so the near side is searched first
+        stack.push_back(make_pair(farChild, max(planeDistance, offset * offset)));
+        stack.push_back(make_pair(nearChild, planeDistance));
+    }
+
+    while (!best.empty()) {
+        ids.push_back(best.top().second);
+        best.pop();
+    }
+    Measure(north, west, ids, miles);
+
+    // Order by kernel distance, ties by id
+    vector<int> order(ids.size());
+    for (int i = 0; i < static_cast<int>(order.size()); i++) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        if (miles[a] != miles[b]) {
+            return miles[a] < miles[b];
+        }
+        return ids[a] < ids[b];
+    });
+    vector<int> sortedIds(ids.size());
+    vector<double> sortedMiles(miles.size());
+    for (int i = 0; i < static_cast<int>(order.size()); i++) {
+        sortedIds[i] = ids[order[i]];
+        sortedMiles[i] = miles[order[i]];
+    }
+    ids.swap(sortedIds);
+    miles.swap(sortedMiles);
+}
+
+void SpatialIndex::Within(double north, double west, double radius, vector<int>& ids,
+                          vector<double>& miles) const {
+    ids.clear();
+    miles.clear();
+    if (m_nodes.empty() || radius < 0) {
+        return;
+    }
+    double query[3];
+    ToUnit(north, west, query[0], query[1], query[2]);
+    double limit = ChordSquared(radius);
+
+    vector<int> candidates;
+    vector<int> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (node.left == -1) {
+            for (int i = node.begin; i < node.end; i++) {
+                double dx = m_x[i] - query[0];
+                double dy = m_y[i] - query[1];
+                double dz = m_z[i] - query[2];
+                if (dx * dx + dy * dy + dz * dz <= limit) {
+                    candidates.push_back(m_ids[i]);
+                }
+            }
+            continue;
+        }
+        double offset = query[node.axis] - node.split;
+        if (offset < 0 || offset * offset <= limit) {
+            stack.push_back(node.left);
+        }
+        if (offset >= 0 || offset * offset <= limit) {
+            stack.push_back(node.right);
+        }
+    }
+
+    // Exact check with the kernel used everywhere else
+    sort(candidates.begin(), candidates.end());
+    vector<double> distances;
+    Measure(north, west, candidates, distances);
+    for (int i = 0; i < static_cast<int>(candidates.size()); i++) {
+        if (distances[i] <= radius) {
+            ids.push_back(candidates[i]);
+            miles.push_back(distances[i]);
+        }
+    }
+}
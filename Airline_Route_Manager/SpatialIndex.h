@@ -0,0 +1,89 @@
+//Name: SpatialIndex.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the SpatialIndex class
+//      Airports are stored as 3D unit vectors in a k-d tree so "k nearest
+//      airports" and "airports within X miles" only visit nearby tree
+//      cells. Straight-line (chord) distance between unit vectors grows
+//      with great-circle distance, so the tree prunes on chords and only
+//      the airports that survive are measured with the haversine kernel.
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <vector>
+
+#include "AirportCatalog.h"
+#include "Column.h"
+using namespace std;
+
+//Constants
+const int KD_LEAF_SIZE = 8; //Most airports stored in one leaf
+
+class SpatialIndex {
+ public:
+  // Name: SpatialIndex() - Default Constructor
+  // Desc: Builds an empty index
+  // Preconditions: None
+  // Postconditions: IsBuilt is false
+  SpatialIndex();
+  // Name: Build(AirportCatalog&)
+  // Desc: Builds the k-d tree from each airport's north/west coordinates
+  //   Airports are identified by their id in the catalog
+  // Preconditions: The catalog outlives the index (or the next Build)
+  // Postconditions: Index holds every airport
+  void Build(const AirportCatalog& catalog);
+  // Name: IsBuilt()
+  // Preconditions: None
+  // Postconditions: Returns true if the index holds airports
+  bool IsBuilt() const;
+  // Name: GetSize()
+  // Preconditions: None
+  // Postconditions: Returns the number of airports indexed
+  int GetSize() const;
+  // Name: Nearest(double, double, int, vector<int>&, vector<double>&, int)
+  // Desc: Finds the k airports closest to a point, skipping exclude
+  //   (pass an airport's own id to leave it out of its neighbours)
+  // Preconditions: Coordinates in degrees
+  // Postconditions: ids and miles hold up to k airports sorted by
+  //   distance (ties by id)
+  void Nearest(double north, double west, int k, vector<int>& ids,
+               vector<double>& miles, int exclude = -1) const;
+  // Name: Within(double, double, double, vector<int>&, vector<double>&)
+  // Desc: Finds every airport at most radius miles from a point
+  //   Uses the same distance as BatchDistanceFrom, so the result is
+  //   exactly the airports a full scan would find
+  // Preconditions: Coordinates in degrees
+  // Postconditions: ids and miles hold the matches sorted by id
+  void Within(double north, double west, double radius, vector<int>& ids,
+              vector<double>& miles) const;
+ private:
+  //One node of the tree; leaves own points [begin, end)
+  //(fixed 32-byte layout so it can be stored in a snapshot)
+  struct Node {
+    int begin; //First point in this cell
+    int end; //One past the last point in this cell
+    int left; //Child below the split (-1 for a leaf)
+    int right; //Child above the split (-1 for a leaf)
+    int axis; //0 = x, 1 = y, 2 = z
+    int unused; //Padding before split
+    double split; //Splitting coordinate
+  };
+  // Name: BuildNode(vector<Node>&, vector<int>&, const vector<double>*[3], int, int)
+  // Desc: Recursively splits ids [begin, end) on their widest axis
+  static int BuildNode(vector<Node>& nodes, vector<int>& ids,
+                       const vector<double>* coords[3], int begin, int end);
+  // Name: Measure(double, double, vector<int>&, vector<double>&)
+  // Desc: Fills miles with the kernel distance to each id
+  void Measure(double north, double west, const vector<int>& ids,
+               vector<double>& miles) const;
+  Column<Node> m_nodes; //Tree nodes, root at 0
+  Column<double> m_x; //Unit vector of each point (tree order)
+  Column<double> m_y;
+  Column<double> m_z;
+  Column<int> m_ids; //Airport id of each point (tree order)
+  const AirportCatalog *m_catalog; //Coordinates by airport id
+  friend class Snapshot; //Saves and attaches the tree
+};
+
+#endif
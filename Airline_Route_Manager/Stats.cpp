@@ -0,0 +1,161 @@
+#include "Stats.h"
+
+#ifdef ARM_STATS
+#include <atomic>
+#include <cstdio>
+
+//One timer's samples
+struct StatHistogram {
+  atomic<long> buckets[STATS_BUCKETS]; //Samples in [2^i, 2^(i+1)) ns
+  atomic<long> calls; //Samples recorded
+  atomic<long> total; //Sum of the samples in ns
+  atomic<long> max; //Longest sample in ns
+};
+
+//Zero-initialized because they are static
+static atomic<long> s_counters[STAT_COUNTER_COUNT];
+static StatHistogram s_timers[STAT_TIMER_COUNT];
+
+static const char* const COUNTER_NAMES[STAT_COUNTER_COUNT] = {
+  "distances", "getdata_calls", "getdata_steps", "routes_created", "route_edits"
+};
+static const char* const TIMER_NAMES[STAT_TIMER_COUNT] = {
+  "load", "read_file", "route_edit", "measure", "plan", "pareto",
+  "optimize", "nearest", "index_query", "network", "ingest", "reach", "command"
+};
+
+// Bucket i holds samples with highest set bit i
+static int Bucket(long ns) {
+    if (ns < 1) {
+        return 0;
+    }
+    int bucket = 63 - __builtin_clzl((unsigned long)ns);
+    return bucket < STATS_BUCKETS ? bucket : STATS_BUCKETS - 1;
+}
+
+// Upper edge of the bucket holding the given fraction of the samples
+static long Percentile(const StatHistogram& histogram, double fraction) {
+    long calls = histogram.calls.load(memory_order_relaxed);
+    if (calls == 0) {
+        return 0;
+    }
+    long wanted = (long)(fraction * calls + 0.999999);
+    long seen = 0;
+    for (int i = 0; i < STATS_BUCKETS; i++) {
+        seen += histogram.buckets[i].load(memory_order_relaxed);
+        if (seen >= wanted) {
+            long edge = 2L << i;
+            long max = histogram.max.load(memory_order_relaxed);
+            return edge < max ? edge : max;
+        }
+    }
+    return histogram.max.load(memory_order_relaxed);
+}
+
+void Stats::Count(StatCounter counter, long amount) {
+    s_counters[counter].fetch_add(amount, memory_order_relaxed);
+}
+
+void Stats::Record(StatTimer timer, long ns) {
+    StatHistogram& histogram = s_timers[timer];
+    histogram.buckets[Bucket(ns)].fetch_add(1, memory_order_relaxed);
+    histogram.calls.fetch_add(1, memory_order_relaxed);
+    histogram.total.fetch_add(ns, memory_order_relaxed);
+    long max = histogram.max.load(memory_order_relaxed);
+    while (ns > max && !histogram.max.compare_exchange_weak(max, ns, memory_order_relaxed)) {
+    }
+}
+
+bool Stats::IsEnabled() {
+    return true;
+}
+
+void Stats::Dump(ostream& out) {
+    char line[160];
+    out << "Counters:" << endl;
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++) {
+        snprintf(line, sizeof(line), "  %-16s %14ld", COUNTER_NAMES[i],
+                 s_counters[i].load(memory_order_relaxed));
+        out << line << endl;
+    }
+
+    out << "Timers (microseconds):" << endl;
+    snprintf(line, sizeof(line), "  %-12s %10s %12s %10s %10s %10s %10s %10s",
+             "timer", "calls", "total", "mean", "p50", "p90", "p99", "max");
+    out << line << endl;
+    for (int i = 0; i < STAT_TIMER_COUNT; i++) {
+        const StatHistogram& histogram = s_timers[i];
+        long calls = histogram.calls.load(memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+        double total = histogram.total.load(memory_order_relaxed) / 1000.0;
+        snprintf(line, sizeof(line), "  %-12s %10ld %12.1f %10.2f %10.2f %10.2f %10.2f %10.2f",
+                 TIMER_NAMES[i], calls, total, total / calls,
+                 Percentile(histogram, 0.50) / 1000.0, Percentile(histogram, 0.90) / 1000.0,
+                 Percentile(histogram, 0.99) / 1000.0,
+                 histogram.max.load(memory_order_relaxed) / 1000.0);
+        out << line << endl;
+    }
+}
+
+void Stats::AppendJSON(string& text) {
+    text += "{\"counters\":{";
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++) {
+        if (i > 0) {
+            text += ',';
+        }
+        text += '"';
+        text += COUNTER_NAMES[i];
+        text += "\":" + to_string(s_counters[i].load(memory_order_relaxed));
+    }
+    text += "},\"timers\":{";
+    for (int i = 0; i < STAT_TIMER_COUNT; i++) {
+        const StatHistogram& histogram = s_timers[i];
+        if (i > 0) {
+            text += ',';
+        }
+        text += '"';
+        text += TIMER_NAMES[i];
+        text += "\":{\"calls\":" + to_string(histogram.calls.load(memory_order_relaxed)) +
+            ",\"total_ns\":" + to_string(histogram.total.load(memory_order_relaxed)) +
+            ",\"p50_ns\":" + to_string(Percentile(histogram, 0.50)) +
+            ",\"p90_ns\":" + to_string(Percentile(histogram, 0.90)) +
+            ",\"p99_ns\":" + to_string(Percentile(histogram, 0.99)) +
+            ",\"max_ns\":" + to_string(histogram.max.load(memory_order_relaxed)) + "}";
+    }
+    text += "}}";
+}
+
+void Stats::Reset() {
+    for (int i = 0; i < STAT_COUNTER_COUNT; i++) {
+        s_counters[i].store(0, memory_order_relaxed);
+    }
+    for (int i = 0; i < STAT_TIMER_COUNT; i++) {
+        for (int b = 0; b < STATS_BUCKETS; b++) {
+            s_timers[i].buckets[b].store(0, memory_order_relaxed);
+        }
+        s_timers[i].calls.store(0, memory_order_relaxed);
+        s_timers[i].total.store(0, memory_order_relaxed);
+        s_timers[i].max.store(0, memory_order_relaxed);
+    }
+}
+
+#else
+
+bool Stats::IsEnabled() {
+    return false;
+}
+
+void Stats::Dump(ostream& out) {
+    out << "Stats are not compiled in (build with make STATS=1)" << endl;
+}
+
+void Stats::AppendJSON(string& text) {
+    text += "{}";
+}
+
+void Stats::Reset() {
+}
+
+#endif
@@ -0,0 +1,117 @@
+//Name: Stats.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the Stats instrumentation
+//      Counters and latency histograms for the hot paths of Navigator,
+//      Route and the batch driver. They are only compiled in when
+//      ARM_STATS is defined (make STATS=1); otherwise the STATS_ macros
+//      expand to nothing and Stats only reports that it is disabled.
+//      Counters and histogram buckets are relaxed atomics so parallel
+//      route work can record without locks.
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <iostream>
+#include <string>
+#ifdef ARM_STATS
+#include <chrono>
+#endif
+using namespace std;
+
+//Constants
+const int STATS_BUCKETS = 48; //Histogram buckets: [2^i, 2^(i+1)) ns
+
+//Counted events
+enum StatCounter {
+  STAT_DISTANCES, //Leg distances computed by routes (cache or kernel)
+  STAT_GETDATA_CALLS, //Route::GetData calls
+  STAT_GETDATA_STEPS, //Linked nodes walked by GetData
+  STAT_ROUTES_CREATED, //Route objects constructed
+  STAT_ROUTE_EDITS, //Airports inserted or removed, and reversals
+  STAT_COUNTER_COUNT
+};
+
+//Timed operations
+enum StatTimer {
+  STAT_LOAD, //Navigator::Load (snapshot or text file)
+  STAT_READ_FILE, //Navigator::ReadFile
+  STAT_ROUTE_EDIT, //InsertEnd, RemoveAirport and ReverseRoute
+  STAT_MEASURE, //Navigator::MeasureRoutes
+  STAT_PLAN, //Navigator::PlanRoute
+  STAT_PARETO, //Navigator::ParetoRoutes
+  STAT_OPTIMIZE, //Navigator::OptimizeRoute
+  STAT_NEAREST, //Navigator::NearestAirports
+  STAT_INDEX_QUERY, //RoutesThrough and SimilarRoutes
+  STAT_NETWORK, //HubAirports and GetNetworkStats
+  STAT_INGEST, //One chunk of a flight-leg log parsed and merged
+  STAT_REACH, //Navigator::Reachable
+  STAT_COMMAND, //One batch command
+  STAT_TIMER_COUNT
+};
+
+class Stats {
+ public:
+  // Name: IsEnabled()
+  // Preconditions: None
+  // Postconditions: Returns true if built with ARM_STATS
+  static bool IsEnabled();
+#ifdef ARM_STATS
+  // Name: Count(StatCounter, long)
+  // Desc: Adds amount to a counter
+  // Preconditions: None
+  // Postconditions: Counter is increased
+  static void Count(StatCounter counter, long amount);
+  // Name: Record(StatTimer, long)
+  // Desc: Adds one sample of ns nanoseconds to a timer's histogram
+  // Preconditions: None
+  // Postconditions: Sample is counted
+  static void Record(StatTimer timer, long ns);
+#endif
+  // Name: Dump(ostream&)
+  // Desc: Writes every counter and each timer's calls, total, mean and
+  //   50th/90th/99th percentile and max
+  //   (percentiles are the upper edge of their bucket)
+  // Preconditions: None
+  // Postconditions: Report is written (one line if disabled)
+  static void Dump(ostream& out);
+  // Name: AppendJSON(string&)
+  // Desc: Appends the same numbers as one JSON object
+  // Preconditions: None
+  // Postconditions: text ends with the object ({} if disabled)
+  static void AppendJSON(string& text);
+  // Name: Reset()
+  // Desc: Sets every counter and histogram back to zero
+  // Preconditions: None
+  // Postconditions: Stats are empty
+  static void Reset();
+};
+
+#ifdef ARM_STATS
+//Records the time from construction to destruction
+class StatScope {
+ public:
+  explicit StatScope(StatTimer timer)
+      : m_timer(timer), m_start(chrono::steady_clock::now()) {
+  }
+  ~StatScope() {
+    Stats::Record(m_timer, (long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - m_start).count());
+  }
+ private:
+  StatTimer m_timer; //Histogram the time goes to
+  chrono::steady_clock::time_point m_start; //When the scope began
+};
+
+#define STATS_CONCAT2(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT2(a, b)
+//Times the rest of the enclosing scope
+#define STATS_TIMER(timer) StatScope STATS_CONCAT(statScope, __LINE__)(timer)
+//Adds amount to a counter
+#define STATS_COUNT(counter, amount) Stats::Count(counter, amount)
+#else
+#define STATS_TIMER(timer) ((void)0)
+#define STATS_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif
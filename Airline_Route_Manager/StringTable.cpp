@@ -0,0 +1,80 @@
+#include "StringTable.h"
+
+//Constants
+const int STRING_SLOTS_MIN = 64; //Initial number of hash slots (power of two)
+
+StringTable::StringTable() {
+    Clear();
+}
+
+void StringTable::Clear() {
+    m_text.clear();
+    m_offsets.assign(1, 0);
+    m_slots.assign(STRING_SLOTS_MIN, 0);
+}
+
+uint64_t StringTable::Hash(string_view text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < text.size(); i++) {
+        hash ^= static_cast<unsigned char>(text[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint32_t StringTable::Intern(string_view text) {
+    size_t mask = m_slots.size() - 1;
+    size_t slot = Hash(text) & mask;
+    // Linear probing until the text or an empty slot is found
+    while (m_slots[slot] != 0) {
+        uint32_t id = m_slots[slot] - 1;
+        if (Get(id) == text) {
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_offsets.size() - 1);
+    m_text.Append(text.data(), text.size());
+    m_offsets.push_back(static_cast<uint32_t>(m_text.size()));
+    m_slots.Set(slot, id + 1);
+    // Keep the load factor under one half
+    if (2 * (size_t)GetCount() > m_slots.size()) {
+        Grow();
+    }
+    return id;
+}
+
+int StringTable::Find(string_view text) const {
+    size_t mask = m_slots.size() - 1;
+    size_t slot = Hash(text) & mask;
+    while (m_slots[slot] != 0) {
+        uint32_t id = m_slots[slot] - 1;
+        if (Get(id) == text) {
+            return static_cast<int>(id);
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void StringTable::Grow() {
+    m_slots.assign(m_slots.size() * 2, 0);
+    size_t mask = m_slots.size() - 1;
+    for (uint32_t id = 0; id < static_cast<uint32_t>(GetCount()); id++) {
+        size_t slot = Hash(Get(id)) & mask;
+        while (m_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots.Set(slot, id + 1);
+    }
+}
+
+int StringTable::GetCount() const {
+    return static_cast<int>(m_offsets.size()) - 1;
+}
+
+size_t StringTable::GetMemoryUsage() const {
+    return m_text.capacity() + m_offsets.capacity() * sizeof(uint32_t) +
+        m_slots.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,74 @@
+//Name: StringTable.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the StringTable class
+//      Interns strings into one contiguous text arena. Each distinct
+//      string is stored once and identified by a 32-bit id, so repeated
+//      cities and countries cost four bytes per airport instead of a
+//      std::string each.
+
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Column.h"
+using namespace std;
+
+class StringTable {
+ public:
+  // Name: StringTable() - Default Constructor
+  // Desc: Builds an empty table
+  // Preconditions: None
+  // Postconditions: Table holds no strings
+  StringTable();
+  // Name: Clear()
+  // Desc: Removes every string
+  // Preconditions: None
+  // Postconditions: Table is empty; old ids are invalid
+  void Clear();
+  // Name: Intern(string_view)
+  // Desc: Returns the id of text, adding it to the arena if it is new
+  // Preconditions: None
+  // Postconditions: Get(returned id) == text
+  uint32_t Intern(string_view text);
+  // Name: Find(string_view)
+  // Desc: Looks text up without adding it
+  // Preconditions: None
+  // Postconditions: Returns the id of text, or -1 if it was never interned
+  int Find(string_view text) const;
+  // Name: Get(uint32_t)
+  // Desc: Returns the text of an id without copying it
+  //   The view points into the arena and stays valid until the next
+  //   Intern or Clear (the arena may move when it grows)
+  // Preconditions: id was returned by Intern
+  // Postconditions: Returns the interned text
+  string_view Get(uint32_t id) const {
+    return string_view(m_text.data() + m_offsets[id], m_offsets[id + 1] - m_offsets[id]);
+  }
+  // Name: GetCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of distinct strings
+  int GetCount() const;
+  // Name: GetMemoryUsage()
+  // Preconditions: None
+  // Postconditions: Returns bytes allocated by the arena and hash slots
+  size_t GetMemoryUsage() const;
+ private:
+  // Name: Hash(string_view)
+  // Desc: 64-bit FNV-1a hash of text
+  static uint64_t Hash(string_view text);
+  // Name: Grow()
+  // Desc: Doubles the hash slots and reinserts every id
+  void Grow();
+  Column<char> m_text; //Every distinct string back to back
+  Column<uint32_t> m_offsets; //String id's text is [m_offsets[id], m_offsets[id+1])
+  Column<uint32_t> m_slots; //Open-addressing hash slots (id + 1, 0 if empty)
+  friend class Snapshot; //Saves and attaches the columns
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "ThreadPool.h"
+
+#include <cstdlib>
+
+ThreadPool::ThreadPool(int threads) {
+    m_threads = threads > 0 ? threads : DefaultThreads();
+    m_pending = 0;
+    m_generation = 0;
+    m_stopping = false;
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (int i = 0; i < static_cast<int>(m_workers.size()); i++) {
+        m_workers[i].join();
+    }
+}
+
+int ThreadPool::DefaultThreads() {
+    const char* forced = getenv("ARM_THREADS");
+    int threads = forced == nullptr ? 0 : atoi(forced);
+    if (threads <= 0) {
+        threads = static_cast<int>(thread::hardware_concurrency());
+    }
+    return threads > 0 ? threads : 1;
+}
+
+int ThreadPool::GetThreadCount() const {
+    return m_threads;
+}
+
+void ThreadPool::Start() {
+    for (int i = 0; i < m_threads; i++) {
+        m_queues.push_back(unique_ptr<Queue>(new Queue()));
+    }
+    for (int i = 1; i < m_threads; i++) {
+        m_workers.push_back(thread(&ThreadPool::WorkerLoop, this, i));
+    }
+}
+
+void ThreadPool::Run(vector<function<void()> >& tasks) {
+    lock_guard<mutex> running(m_runLock);
+    int count = static_cast<int>(tasks.size());
+    // Nothing to share: run inline without waking anyone
+    if (m_threads == 1 || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            tasks[i]();
+        }
+        return;
+    }
+    if (m_queues.empty()) {
+        Start();
+    }
+
+    // Deal the tasks round-robin so each thread starts on a large one
+    m_pending = count;
+    for (int i = 0; i < count; i++) {
+        Queue& queue = *m_queues[i % m_threads];
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks.push_front(&tasks[i]);
+    }
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    while (RunOne(0)) {
+    }
+    // Others may still be finishing tasks they took
+    unique_lock<mutex> guard(m_lock);
+    m_done.wait(guard, [this] { return m_pending == 0; });
+}
+
+bool ThreadPool::RunOne(int index) {
+    function<void()>* task = nullptr;
+    // Own queue from the back, then steal from the front of the others
+    for (int i = 0; i < m_threads && task == nullptr; i++) {
+        Queue& queue = *m_queues[(index + i) % m_threads];
+        lock_guard<mutex> guard(queue.lock);
+        if (!queue.tasks.empty()) {
+            if (i == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+        }
+    }
+    if (task == nullptr) {
+        return false;
+    }
+    (*task)();
+    if (--m_pending == 0) {
+        // Lock so the waiting caller cannot miss the signal
+        lock_guard<mutex> guard(m_lock);
+        m_done.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::WorkerLoop(int index) {
+    int seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(m_lock);
+            m_wake.wait(guard, [this, seen] { return m_stopping || m_generation != seen; });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_generation;
+        }
+        while (RunOne(index)) {
+        }
+    }
+}
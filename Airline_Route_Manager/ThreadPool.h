@@ -0,0 +1,83 @@
+//Name: ThreadPool.h
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: This file contains the header details for the ThreadPool class
+//      A fixed set of worker threads, each with its own task queue.
+//      Run deals a batch of tasks across the queues; a thread takes from
+//      the back of its own queue and, once that is empty, steals from the
+//      front of the others, so uneven tasks still keep every thread busy.
+//      The calling thread works too. Threads start on the first Run.
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+using namespace std;
+
+class ThreadPool {
+ public:
+  // Name: ThreadPool(int) - Overloaded Constructor
+  // Desc: Builds a pool that runs tasks on threads threads (counting the
+  //   caller). 0 uses DefaultThreads().
+  // Preconditions: threads >= 0
+  // Postconditions: No threads are started yet
+  ThreadPool(int threads = 0);
+  // Name: ~ThreadPool() - Destructor
+  // Desc: Stops and joins the workers
+  // Preconditions: No Run in progress
+  // Postconditions: All threads are joined
+  ~ThreadPool();
+  // Name: Run(vector<function<void()>>&)
+  // Desc: Runs every task and returns once all have finished. Tasks are
+  //   started roughly in the order given, so put the largest first.
+  //   Only one Run is in progress at a time (others wait).
+  // Preconditions: Tasks do not call Run on this pool
+  // Postconditions: Every task has run exactly once
+  void Run(vector<function<void()> >& tasks);
+  // Name: GetThreadCount()
+  // Preconditions: None
+  // Postconditions: Returns the number of threads tasks run on
+  int GetThreadCount() const;
+  // Name: DefaultThreads()
+  // Desc: ARM_THREADS if set, otherwise the number of hardware threads
+  // Preconditions: None
+  // Postconditions: Returns at least 1
+  static int DefaultThreads();
+ private:
+  //Tasks dealt to one thread (index 0 is the caller of Run)
+  struct Queue {
+    mutex lock;
+    deque<function<void()>*> tasks;
+  };
+  // Name: Start()
+  // Desc: Creates the queues and launches the workers
+  void Start();
+  // Name: WorkerLoop(int)
+  // Desc: Sleeps until a batch is posted, then runs tasks until none are left
+  void WorkerLoop(int index);
+  // Name: RunOne(int)
+  // Desc: Runs one task from queue index, or stolen from another queue
+  //   Returns false if every queue is empty
+  bool RunOne(int index);
+  ThreadPool(const ThreadPool&); //Not copyable
+  ThreadPool& operator=(const ThreadPool&); //Not assignable
+  int m_threads; //Threads that run tasks (workers + caller)
+  vector<thread> m_workers; //Started on the first Run
+  vector<unique_ptr<Queue> > m_queues; //One per thread
+  mutex m_runLock; //Held for a whole Run
+  mutex m_lock; //Guards m_generation and m_stopping
+  condition_variable m_wake; //Signalled when a batch is posted
+  condition_variable m_done; //Signalled when the last task finishes
+  atomic<int> m_pending; //Tasks of the current batch not yet finished
+  int m_generation; //Incremented for every batch
+  bool m_stopping; //Set by the destructor
+};
+
+#endif
@@ -0,0 +1,111 @@
+//Name: batch_test.cpp
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: Tests for batch commands. Each case runs one command line through
+//      a BatchDriver (JSON lines) against proj3_data.txt and checks whether
+//      it succeeded and that its answer contains an expected piece of
+//      text. Every answer must be exactly one line. Cases run in order,
+//      so later ones see the routes earlier ones created. The read-only
+//      cases then run through a second, read-only driver on the same
+//      routes. Prints each failure and exits with 1 if there were any.
+//
+//      Usage: ./proj3_btest [--data FILE]
+
+#include "Navigator.h"
+#include "BatchDriver.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+//One command and what its answer must hold
+struct BatchCase {
+  const char* command; //Command line
+  bool ok; //Whether it should succeed
+  const char* expect; //Text the answer must contain
+};
+
+const BatchCase BATCH_CASES[] = {
+  {"create JFK LAX ORD", true, "\"route\":1,"},
+  {"plan JFK JFK 3000", false, "must be different"},
+  {"plan JFK LAX 3000", true, "\"route\":2,"},
+  {"reverse 2", true, "\"airports\":[\"LAX\",\"JFK\"]"},
+  {"display 3", false, "usage: display ROUTE"},
+  {"optimize 1 fixed", true, "\"name\":\"NEW YORK to CHICAGO\""},
+  {"optimize 3", false, "usage: optimize"},
+  {"similar 2 1", true, "\"matches\":[1]"},
+  {"similar 3 1", false, "usage: similar"},
+  {"pareto JFK JFK 3000", false, "must be different"},
+  {"shape 1 points 3 polyline", true, "\"polyline\":\""},
+  {"shape 1 miles 0.001", false, "at most"},
+  {"stats", true, "\"memory\":{\"catalog\":"},
+};
+
+const BatchCase READ_ONLY_CASES[] = {
+  {"create JFK LAX", false, "read-only"},
+  {"plan JFK LAX 3000", true, "\"name\":\"NEW YORK to LOS ANGELES\""},
+  {"display 3", false, "usage: display ROUTE"},
+  {"score JFK LAX ORD", true, "\"legs\":2,"},
+  {"reverse 1", false, "read-only"},
+  {"remove 1 LAX", false, "read-only"},
+  {"optimize 1", false, "read-only"},
+  {"ingest /etc/passwd", false, "read-only"},
+  {"display 1", true, "\"route\":1,"},
+  {"distance JFK LAX", true, "\"miles\":"},
+  {"score JFK", false, "at least"},
+  {"score JFK XXX", false, "unknown airport"},
+};
+
+// Name: RunCases(BatchDriver&, BatchCase*, int)
+// Desc: Runs count cases and prints each one that fails
+// Preconditions: None
+// Postconditions: Returns the number of failures
+int RunCases(BatchDriver& driver, const BatchCase* cases, int count) {
+  int failures = 0;
+  for (int i = 0; i < count; i++) {
+    const BatchCase& test = cases[i];
+    string answer;
+    bool ok = driver.RunCommand(test.command, i + 1, answer);
+    bool oneLine = !answer.empty() && answer.find('\n') == answer.size() - 1;
+    if (ok != test.ok || !oneLine || answer.find(test.expect) == string::npos) {
+      cerr << "FAIL " << test.command << ": " << answer;
+      failures++;
+    }
+  }
+  return failures;
+}
+
+int main(int argc, char* argv[]) {
+  string dataFile = "proj3_data.txt";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+      dataFile = argv[++i];
+    } else {
+      cout << "Usage: ./proj3_btest [--data FILE]" << endl;
+      return 1;
+    }
+  }
+
+  ostream nowhere(nullptr); // Load messages are not wanted
+  Navigator navigator(dataFile);
+  navigator.SetLogStream(nowhere);
+  navigator.ReadFile();
+  if (navigator.GetAirportCount() < ROUTE_MIN) {
+    cerr << "Error loading " << dataFile << endl;
+    return 1;
+  }
+  BatchDriver driver(navigator, nowhere, BATCH_JSON);
+  BatchDriver readOnly(navigator, nowhere, BATCH_JSON);
+  readOnly.SetReadOnly(true);
+
+  int cases = static_cast<int>(sizeof(BATCH_CASES) / sizeof(BATCH_CASES[0]));
+  int readOnlyCases = static_cast<int>(sizeof(READ_ONLY_CASES) / sizeof(READ_ONLY_CASES[0]));
+  int failures = RunCases(driver, BATCH_CASES, cases);
+  failures += RunCases(readOnly, READ_ONLY_CASES, readOnlyCases);
+  cases += readOnlyCases;
+
+  cout << cases << " cases" << endl;
+  cout << (failures == 0 ? "PASS" : "FAIL") << " (" << failures << " failures)" << endl;
+  return failures == 0 ? 0 : 1;
+}
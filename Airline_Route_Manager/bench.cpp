@@ -0,0 +1,409 @@
+//Name: bench.cpp
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: Benchmarks for the Navigator on synthetic airport sets (40 to
+//      100000 airports). Micro benchmarks time single calls (distance,
+//      route access and mutation, nearest airports); macro benchmarks
+//      time loading a file, measuring every route and planning routes
+//      (shortest and Pareto).
+//      Each benchmark reports ns/op, heap allocations/op (operator new
+//      calls; the cache's aligned_alloc is not counted) and throughput.
+//      A table goes to cout and one JSON object per benchmark goes to
+//      the --json file so runs can be compared between builds.
+//
+//      Usage: ./proj3_bench [--json FILE] [--max AIRPORTS] [--min-ms MS]
+
+#include "Navigator.h"
+#include "Haversine.h"
+#include "DistanceModel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+//Every operator new in the process is counted. The replacements are
+//not inlined so the compiler never pairs operator new with free.
+static atomic<long> g_allocs(0); //Calls to operator new
+static atomic<long> g_allocBytes(0); //Bytes requested from operator new
+
+__attribute__((noinline)) void* operator new(size_t size) {
+  g_allocs.fetch_add(1, memory_order_relaxed);
+  g_allocBytes.fetch_add((long)size, memory_order_relaxed);
+  void* memory = malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw bad_alloc();
+  }
+  return memory;
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept {
+  free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+  free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory, size_t) noexcept {
+  free(memory);
+}
+
+//Constants
+const int BENCH_SIZES[] = {40, 1000, 10000, 100000}; //Airport set sizes
+const int BENCH_SIZE_COUNT = 4;
+const double BENCH_MIN_MS = 200.0; //Default time each benchmark runs for
+const int BENCH_ROUTE_STOPS = 4096; //Stops in the long route
+const int BENCH_ROUTES = 256; //Routes measured by measure_routes
+const int BENCH_ROUTE_LENGTH = 512; //Stops in each of those routes
+const int BENCH_NEIGHBOURS = 30; //Airports in range of each, on average, for plan_route
+const int BENCH_NEAREST = 10; //Airports found by nearest
+const int BENCH_PAIRS = 4096; //Random airport pairs reused by the pair benchmarks
+const unsigned BENCH_SEED = 20261017; //Seed for the synthetic data
+
+//One benchmark's result
+struct BenchResult {
+  string name; //Benchmark name
+  int airports; //Airports loaded
+  long ops; //Operations timed
+  long items; //Items processed (airports, legs...) during those ops
+  double seconds; //Time taken
+  long allocs; //operator new calls during the run
+  long bytes; //Bytes requested during the run
+};
+
+double g_sink = 0.0; //Results are added here so no work is optimized away
+
+// Name: Measure(string, int, Body)
+// Desc: Calls body(iterations) with doubling iterations until one call
+//   takes at least minMs. body returns the items it processed.
+// Preconditions: body does iterations operations
+// Postconditions: Returns the last (longest) call's numbers
+template <class Body>
+BenchResult Measure(const string& name, int airports, double minMs, Body body) {
+  BenchResult result = {name, airports, 0, 0, 0.0, 0, 0};
+  for (long iterations = 1; ; iterations *= 2) {
+    long allocs = g_allocs.load();
+    long bytes = g_allocBytes.load();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    long items = body(iterations);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.ops = iterations;
+    result.items = items;
+    result.seconds = seconds;
+    result.allocs = g_allocs.load() - allocs;
+    result.bytes = g_allocBytes.load() - bytes;
+    if (seconds * 1000.0 >= minMs || iterations >= (1L << 40)) {
+      return result;
+    }
+  }
+}
+
+// Name: Report(BenchResult&, ostream&)
+// Desc: Writes one table row to cout and one JSON line to json
+// Preconditions: None
+// Postconditions: Both are written
+void Report(const BenchResult& result, ostream& json) {
+  double nsPerOp = result.seconds * 1e9 / result.ops;
+  double allocsPerOp = (double)result.allocs / result.ops;
+  double bytesPerOp = (double)result.bytes / result.ops;
+  double opsPerSec = result.ops / result.seconds;
+  double itemsPerSec = result.items / result.seconds;
+  cout << left << setw(24) << result.name << right << setw(8) << result.airports
+       << fixed << setprecision(1) << setw(14) << nsPerOp
+       << setprecision(2) << setw(12) << allocsPerOp
+       << setprecision(0) << setw(16) << itemsPerSec << endl;
+
+  char line[512];
+  snprintf(line, sizeof(line),
+           "{\"benchmark\":\"%s\",\"airports\":%d,\"ops\":%ld,\"items\":%ld,"
+           "\"ns_per_op\":%.2f,\"allocs_per_op\":%.3f,\"bytes_per_op\":%.1f,"
+           "\"ops_per_sec\":%.1f,\"items_per_sec\":%.1f,\"compiler\":\"%s\"}\n",
+           result.name.c_str(), result.airports, result.ops, result.items,
+           nsPerOp, allocsPerOp, bytesPerOp, opsPerSec, itemsPerSec, __VERSION__);
+  json << line;
+}
+
+// Name: MeasureModel<Model>(string, int, double, vector<int>&, vector<double>&, vector<double>&)
+// Desc: Times Model::Distance over the random airport pairs
+// Preconditions: pairs holds 2 * BENCH_PAIRS airport ids
+// Postconditions: Returns the result
+template <class Model>
+BenchResult MeasureModel(const string& name, int airports, double minMs, const vector<int>& pairs,
+                         const vector<double>& norths, const vector<double>& wests) {
+  return Measure(name, airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      int a = pairs[2 * (i % BENCH_PAIRS)];
+      int b = pairs[2 * (i % BENCH_PAIRS) + 1];
+      g_sink += Model::Distance(norths[a], wests[a], norths[b], wests[b]);
+    }
+    return iterations;
+  });
+}
+
+// Name: WriteAirports(string, int)
+// Desc: Writes count airports spread evenly over the globe. The first
+//   17576 get three-letter codes, the rest longer ones.
+// Preconditions: None
+// Postconditions: Returns false if the file could not be written
+bool WriteAirports(const string& fileName, int count) {
+  ofstream out(fileName.c_str());
+  if (!out.is_open()) {
+    return false;
+  }
+  mt19937 random(BENCH_SEED + count);
+  uniform_real_distribution<double> unit(-1.0, 1.0);
+  uniform_real_distribution<double> longitude(-180.0, 180.0);
+  out << fixed << setprecision(4);
+  for (int i = 0; i < count; i++) {
+    string code;
+    if (i < 26 * 26 * 26) {
+      code += (char)('A' + i / 676);
+      code += (char)('A' + i / 26 % 26);
+      code += (char)('A' + i % 26);
+    } else {
+      code = "B" + to_string(i);
+    }
+    // asin of a uniform value is uniform over the sphere's area
+    double north = asin(unit(random)) * 180.0 / M_PI;
+    out << code << ",AIRPORT " << i << ",CITY " << i % 997 << ",COUNTRY " << i % 193
+        << "," << north << "," << longitude(random) << "\n";
+  }
+  return out.good();
+}
+
+// Name: BuildRoute(vector<Airport*>&, DistanceCache&, vector<int>&)
+// Desc: Builds a named indexed route through stops, as the Navigator does
+// Preconditions: Every id is valid in table
+// Postconditions: Returns a new dynamically allocated route
+Route* BuildRoute(const vector<Airport*>& table, const DistanceCache& cache,
+                  const vector<int>& stops) {
+  Route* route = new Route(&table, &cache);
+  for (int i = 0; i < static_cast<int>(stops.size()); i++) {
+    route->InsertEnd(stops[i]);
+  }
+  route->SetName(route->UpdateName());
+  return route;
+}
+
+// Name: RunSize(int, double, ostream&)
+// Desc: Runs every benchmark on a synthetic set of airports
+// Preconditions: None
+// Postconditions: Results are reported; the data file is removed
+void RunSize(int airports, double minMs, ostream& json) {
+  string fileName = "bench_airports_" + to_string(airports) + ".txt";
+  if (!WriteAirports(fileName, airports)) {
+    cerr << "Error writing " << fileName << endl;
+    return;
+  }
+  ostream nowhere(nullptr); // Load messages are not wanted
+
+  // Macro: parse the file and build the indexes
+  Report(Measure("read_file", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      Navigator navigator(fileName);
+      navigator.SetLogStream(nowhere);
+      navigator.ReadFile();
+      g_sink += navigator.GetAirportCount();
+    }
+    return iterations * airports;
+  }), json);
+
+  Navigator navigator(fileName);
+  navigator.SetLogStream(nowhere);
+  navigator.ReadFile();
+  mt19937 random(BENCH_SEED);
+  uniform_int_distribution<int> anyAirport(0, airports - 1);
+  vector<int> pairs(2 * BENCH_PAIRS);
+  for (int i = 0; i < 2 * BENCH_PAIRS; i++) {
+    pairs[i] = anyAirport(random);
+  }
+  vector<double> norths(airports), wests(airports), miles(airports);
+  for (int i = 0; i < airports; i++) {
+    norths[i] = navigator.GetAirport(i)->GetNorth();
+    wests[i] = navigator.GetAirport(i)->GetWest();
+  }
+
+  // Micro: one great-circle distance
+  Report(Measure("calc_distance", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      int a = pairs[2 * (i % BENCH_PAIRS)];
+      int b = pairs[2 * (i % BENCH_PAIRS) + 1];
+      g_sink += navigator.CalcDistance(norths[a], wests[a], norths[b], wests[b]);
+    }
+    return iterations;
+  }), json);
+  Report(Measure("batch_distance_from", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      int a = pairs[i % (2 * BENCH_PAIRS)];
+      BatchDistanceFrom(norths[a], wests[a], norths.data(), wests.data(), miles.data(), airports);
+      g_sink += miles[airports - 1];
+    }
+    return iterations * airports;
+  }), json);
+
+  Report(MeasureModel<HaversineModel<Miles> >("model_haversine", airports, minMs, pairs, norths, wests), json);
+  Report(MeasureModel<EquirectangularModel<Miles> >("model_equirectangular", airports, minMs, pairs, norths, wests), json);
+  Report(MeasureModel<VincentyModel<Miles> >("model_vincenty", airports, minMs, pairs, norths, wests), json);
+  Report(MeasureModel<ChordModel<Miles> >("model_chord", airports, minMs, pairs, norths, wests), json);
+
+  // Micro: one long route
+  vector<int> stops(BENCH_ROUTE_STOPS);
+  for (int i = 0; i < BENCH_ROUTE_STOPS; i++) {
+    stops[i] = anyAirport(random);
+  }
+  Route* route = navigator.GetRoute(navigator.AddRoute(stops));
+  vector<Airport*> table;
+  for (int i = 0; i < navigator.GetAirportCount(); i++) {
+    table.push_back(navigator.GetAirport(i));
+  }
+  Report(Measure("route_distance", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      g_sink += navigator.RouteDistance(route);
+    }
+    return iterations;
+  }), json);
+  Report(Measure("measure_route", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      g_sink += navigator.MeasureRoute(route).maxLeg;
+    }
+    return iterations * (BENCH_ROUTE_STOPS - 1);
+  }), json);
+  Report(Measure("route_get_data", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      g_sink += route->GetData((int)(i % BENCH_ROUTE_STOPS))->GetNorth();
+    }
+    return iterations;
+  }), json);
+  // Micro: route mutations (route_remove_airport includes building the
+  // route, which route_insert_end times on its own)
+  Report(Measure("route_insert_end", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      Route* built = BuildRoute(table, navigator.GetDistances(), stops);
+      g_sink += built->GetDistance();
+      delete built;
+    }
+    return iterations * BENCH_ROUTE_STOPS;
+  }), json);
+  Report(Measure("route_remove_airport", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      Route* built = BuildRoute(table, navigator.GetDistances(), stops);
+      while (built->GetSize() > ROUTE_MIN) {
+        built->RemoveAirport(built->GetSize() / 2);
+      }
+      g_sink += built->GetDistance();
+      delete built;
+    }
+    return iterations * (BENCH_ROUTE_STOPS - ROUTE_MIN);
+  }), json);
+  Report(Measure("nearest", airports, minMs, [&](long iterations) {
+    vector<int> ids;
+    vector<double> found;
+    for (long i = 0; i < iterations; i++) {
+      navigator.NearestAirports(pairs[i % (2 * BENCH_PAIRS)], BENCH_NEAREST, ids, found);
+      g_sink += found.empty() ? 0.0 : found.back();
+    }
+    return iterations;
+  }), json);
+
+  // Macro: measure many stored routes in parallel
+  for (int r = 0; r < BENCH_ROUTES; r++) {
+    vector<int> ids(BENCH_ROUTE_LENGTH);
+    for (int i = 0; i < BENCH_ROUTE_LENGTH; i++) {
+      ids[i] = anyAirport(random);
+    }
+    navigator.AddRoute(ids);
+  }
+  Report(Measure("measure_routes", airports, minMs, [&](long iterations) {
+    long legs = 0;
+    vector<RouteStats> stats;
+    for (long i = 0; i < iterations; i++) {
+      RouteStats totals = navigator.MeasureRoutes(stats);
+      g_sink += totals.miles;
+      legs += totals.legs;
+    }
+    return legs;
+  }), json);
+
+  // Macro: shortest routes where about BENCH_NEIGHBOURS airports are in
+  // range of each (the area of a cap is proportional to 1 - cos)
+  double fraction = (double)BENCH_NEIGHBOURS / airports;
+  double range = fraction >= 1.0 ? 0.0 : EARTH_RADIUS * acos(1.0 - 2.0 * fraction);
+  Route* warm = navigator.PlanRoute(pairs[0], pairs[1], range); // Builds the edges
+  delete warm;
+  Report(Measure("plan_route", airports, minMs, [&](long iterations) {
+    for (long i = 0; i < iterations; i++) {
+      Route* planned = navigator.PlanRoute(pairs[2 * (i % BENCH_PAIRS)],
+                                           pairs[2 * (i % BENCH_PAIRS) + 1], range);
+      if (planned != nullptr) {
+        g_sink += planned->GetDistance();
+        delete planned;
+      }
+    }
+    return iterations;
+  }), json);
+  Report(Measure("pareto_routes", airports, minMs, [&](long iterations) {
+    long found = 0;
+    vector<Route*> routes;
+    for (long i = 0; i < iterations; i++) {
+      found += navigator.ParetoRoutes(pairs[2 * (i % BENCH_PAIRS)], pairs[2 * (i % BENCH_PAIRS) + 1],
+                                      range, PARETO_MAX_HOPS, routes);
+      for (int r = 0; r < static_cast<int>(routes.size()); r++) {
+        g_sink += routes[r]->GetDistance();
+        delete routes[r];
+      }
+    }
+    return found;
+  }), json);
+
+  remove(fileName.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  string jsonFile = "bench.json";
+  int maxAirports = BENCH_SIZES[BENCH_SIZE_COUNT - 1];
+  double minMs = BENCH_MIN_MS;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      jsonFile = argv[++i];
+    } else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+      maxAirports = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+      minMs = atof(argv[++i]);
+    } else {
+      cout << "Usage: ./proj3_bench [--json FILE] [--max AIRPORTS] [--min-ms MS]" << endl;
+      return 1;
+    }
+  }
+  ofstream json(jsonFile.c_str());
+  if (!json.is_open()) {
+    cerr << "Error opening file " << jsonFile << endl;
+    return 1;
+  }
+
+  cout << left << setw(24) << "benchmark" << right << setw(8) << "airports"
+       << setw(14) << "ns/op" << setw(12) << "allocs/op" << setw(16) << "items/s" << endl;
+  for (int i = 0; i < BENCH_SIZE_COUNT && BENCH_SIZES[i] <= maxAirports; i++) {
+    RunSize(BENCH_SIZES[i], minMs, json);
+  }
+  cout << "Results written to " << jsonFile << endl;
+  return g_sink == -1.0 ? 1 : 0;
+}
@@ -0,0 +1,249 @@
+//Name: loadgen.cpp
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: Load generator for server mode (./proj3 DATA --serve SOCKET).
+//      Each client thread opens its own connection and keeps DEPTH
+//      requests in flight: a random mix of airport pair distances,
+//      nearest-airport queries, route scores and reachability queries
+//      (the server is read-only, so nothing a client sends changes its
+//      state). Every answer is matched to its request in order and timed
+//      from just before the request was sent. Prints throughput and the
+//      latency percentiles over all requests, and exits with 1 if any
+//      request failed or the server could not be reached.
+//
+//      Usage: ./proj3_loadgen [--socket PATH] [--data FILE] [--clients N]
+//                             [--requests N] [--depth N]
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+//Constants
+const char* const LOAD_SOCKET = "proj3.sock"; //Default socket path
+const int LOAD_CLIENTS = 4; //Default client threads
+const int LOAD_REQUESTS = 20000; //Default requests per client
+const int LOAD_DEPTH = 16; //Default requests in flight per client
+const int LOAD_NEAREST = 5; //Airports asked for by nearest requests
+const int LOAD_ROUTE_STOPS = 8; //Stops in each score request
+const int LOAD_RANGE = 1500; //Miles per leg in reach requests
+const int LOAD_CONNECT_MS = 5000; //How long to wait for the server to start
+const unsigned LOAD_SEED = 20261017; //Seed for the request mix
+
+//What one client saw
+struct ClientResult {
+  vector<long> latencies; //Nanoseconds per request, in order
+  long failures; //Answers with "ok":false, or lost answers
+  string error; //Why the client stopped early ("" if it did not)
+};
+
+// Name: Connect(string&)
+// Desc: Connects to the server, retrying until LOAD_CONNECT_MS has passed
+int Connect(const string& path) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    return -1;
+  }
+  memcpy(address.sun_path, path.c_str(), path.size());
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  while (true) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+      return fd;
+    }
+    close(fd);
+    if (chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() > LOAD_CONNECT_MS) {
+      return -1;
+    }
+    this_thread::sleep_for(chrono::milliseconds(20));
+  }
+}
+
+// Name: SendAll(int, string&)
+// Desc: Sends every byte of text; false if the connection broke
+bool SendAll(int fd, const string& text) {
+  size_t sent = 0;
+  while (sent < text.size()) {
+    ssize_t bytes = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+    if (bytes <= 0) {
+      return false;
+    }
+    sent += bytes;
+  }
+  return true;
+}
+
+// Name: Client(string&, vector<string>&, int, int, unsigned, ClientResult&)
+// Desc: Runs one connection's requests and records their latencies
+void Client(const string& path, const vector<string>& codes, int requests, int depth,
+            unsigned seed, ClientResult& result) {
+  result.failures = 0;
+  int fd = Connect(path);
+  if (fd < 0) {
+    result.error = "cannot connect to " + path;
+    return;
+  }
+  mt19937 random(seed);
+  int airports = static_cast<int>(codes.size());
+  string pending;
+  char buffer[1 << 16];
+
+  vector<chrono::steady_clock::time_point> starts(requests);
+  result.latencies.reserve(requests);
+  int sent = 0;
+  int done = 0;
+  string batch;
+  while (done < requests) {
+    // Top up to depth requests in flight, sent together
+    batch.clear();
+    for (; sent < requests && sent - done < depth; sent++) {
+      int kind = static_cast<int>(random() % 10);
+      if (kind < 4) {
+        batch += "distance " + codes[random() % airports] + " " + codes[random() % airports] + "\n";
+      } else if (kind < 6) {
+        batch += "nearest " + codes[random() % airports] + " " + to_string(LOAD_NEAREST) + "\n";
+      } else if (kind < 9) {
+        batch += "score";
+        for (int i = 0; i < LOAD_ROUTE_STOPS; i++) {
+          batch += " " + codes[random() % airports];
+        }
+        batch += "\n";
+      } else {
+        batch += "reach " + codes[random() % airports] + " " + codes[random() % airports] + " " +
+            to_string(LOAD_RANGE) + "\n";
+      }
+      starts[sent] = chrono::steady_clock::now();
+    }
+    if (!batch.empty() && !SendAll(fd, batch)) {
+      result.error = "connection lost while sending";
+      break;
+    }
+    ssize_t bytes = read(fd, buffer, sizeof(buffer));
+    if (bytes <= 0) {
+      result.error = "connection closed by the server";
+      break;
+    }
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    pending.append(buffer, bytes);
+    size_t begin = 0;
+    size_t newline;
+    while ((newline = pending.find('\n', begin)) != string::npos && done < sent) {
+      size_t ok = pending.find("\"ok\":true", begin);
+      if (ok == string::npos || ok > newline) {
+        result.failures++;
+      }
+      result.latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(now - starts[done]).count());
+      done++;
+      begin = newline + 1;
+    }
+    pending.erase(0, begin);
+  }
+  result.failures += requests - done;
+  close(fd);
+}
+
+// Name: Percentile(vector<long>&, double)
+// Desc: Value at fraction p of sorted samples, in microseconds
+double Percentile(const vector<long>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[index] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+  string path = LOAD_SOCKET;
+  string dataFile = "proj3_data.txt";
+  int clients = LOAD_CLIENTS;
+  int requests = LOAD_REQUESTS;
+  int depth = LOAD_DEPTH;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+      path = argv[++i];
+    } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+      dataFile = argv[++i];
+    } else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+      clients = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+      requests = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+      depth = atoi(argv[++i]);
+    } else {
+      cout << "Usage: ./proj3_loadgen [--socket PATH] [--data FILE] [--clients N]"
+           << " [--requests N] [--depth N]" << endl;
+      return 1;
+    }
+  }
+  if (clients < 1 || requests < 1 || depth < 1) {
+    cerr << "--clients, --requests and --depth must be at least 1" << endl;
+    return 1;
+  }
+
+  // Airport codes are the first field of each line
+  vector<string> codes;
+  ifstream data(dataFile.c_str());
+  string line;
+  while (getline(data, line)) {
+    size_t comma = line.find(',');
+    if (comma != string::npos && comma > 0) {
+      codes.push_back(line.substr(0, comma));
+    }
+  }
+  if (codes.empty()) {
+    cerr << "Error loading " << dataFile << endl;
+    return 1;
+  }
+
+  vector<ClientResult> results(clients);
+  vector<thread> threads;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int i = 0; i < clients; i++) {
+    threads.push_back(thread(Client, cref(path), cref(codes), requests, depth,
+                             LOAD_SEED + i, ref(results[i])));
+  }
+  for (int i = 0; i < clients; i++) {
+    threads[i].join();
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  vector<long> latencies;
+  long failures = 0;
+  for (int i = 0; i < clients; i++) {
+    if (!results[i].error.empty()) {
+      cerr << "Client " << i + 1 << ": " << results[i].error << endl;
+    }
+    failures += results[i].failures;
+    latencies.insert(latencies.end(), results[i].latencies.begin(), results[i].latencies.end());
+  }
+  sort(latencies.begin(), latencies.end());
+  double total = 0.0;
+  for (int i = 0; i < static_cast<int>(latencies.size()); i++) {
+    total += latencies[i];
+  }
+
+  cout << clients << " clients, depth " << depth << ", " << latencies.size() << " requests in "
+       << seconds << " s (" << static_cast<long>(latencies.size() / seconds) << " requests/s)" << endl;
+  cout << "latency us: mean " << (latencies.empty() ? 0.0 : total / latencies.size() / 1000.0)
+       << "  p50 " << Percentile(latencies, 0.50) << "  p90 " << Percentile(latencies, 0.90)
+       << "  p99 " << Percentile(latencies, 0.99) << "  p99.9 " << Percentile(latencies, 0.999)
+       << "  max " << (latencies.empty() ? 0.0 : latencies.back() / 1000.0) << endl;
+  cout << (failures == 0 ? "PASS" : "FAIL") << " (" << failures << " failures)" << endl;
+  return failures == 0 ? 0 : 1;
+}
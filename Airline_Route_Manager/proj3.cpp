@@ -1,5 +1,9 @@
 #include "Navigator.h"
+#include "BatchDriver.h"
+#include "RouteServer.h"
 #include <iostream>
+#include <fstream>
+#include <cstring>
 using namespace std;
 
 int main (int argc, char* argv[]) {
@@ -8,12 +12,90 @@ int main (int argc, char* argv[]) {
       cout << "You are missing a data file." << endl;
       cout << "Expected usage ./proj3 proj3_data.txt" << endl;
       cout << "File 1 should be a file with airport data" << endl;
+      cout << "Batch usage ./proj3 proj3_data.txt --batch [script] [--csv]" << endl;
+      cout << "Server usage ./proj3 proj3_data.txt --serve socket [--allow-edits]" << endl;
+      cout << "Add --stats to write counters and timers to stderr on exit" << endl;
+      return 0;
+    }
+  // Dump the instrumentation on exit (see Stats.h)
+  bool dumpStats = false;
+  bool allowEdits = false;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--stats") == 0) {
+      dumpStats = true;
+    } else if (strcmp(argv[i], "--allow-edits") == 0) {
+      allowEdits = true;
+    }
+  }
+  if (argc > 2 && strcmp(argv[2], "--batch") == 0)
+    {
+      // Commands from a script (or stdin); results only on stdout
+      BatchFormat format = BATCH_JSON;
+      const char* script = nullptr;
+      for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+          format = BATCH_CSV;
+        } else if (strcmp(argv[i], "-") != 0 && strncmp(argv[i], "--", 2) != 0) {
+          script = argv[i];
+        }
+      }
+      ios::sync_with_stdio(false);
+      Navigator S = Navigator(argv[1]);
+      S.SetLogStream(cerr);
+      S.Load(false);
+      BatchDriver driver(S, cout, format);
+      int failures;
+      if (script != nullptr) {
+        ifstream in(script);
+        if (!in.is_open()) {
+          cerr << "Error opening file " << script << endl;
+          return 1;
+        }
+        failures = driver.Run(in);
+      } else {
+        failures = driver.Run(cin);
+      }
+      if (dumpStats) {
+        Stats::Dump(cerr);
+      }
+      return failures > 0 ? 1 : 0;
+    }
+  else if (argc > 2 && strcmp(argv[2], "--serve") == 0)
+    {
+      // Batch commands over a Unix domain socket until SIGINT or SIGTERM
+      // (read-only unless --allow-edits)
+      if (argc < 4 || strncmp(argv[3], "--", 2) == 0) {
+        cout << "Server usage ./proj3 proj3_data.txt --serve socket [--allow-edits]" << endl;
+        return 1;
+      }
+      Navigator S = Navigator(argv[1]);
+      S.SetLogStream(cerr);
+      S.Load(false);
+      RouteServer server(S, allowEdits);
+      if (!server.Listen(argv[3])) {
+        cerr << "Error: " << server.GetError() << endl;
+        return 1;
+      }
+      cerr << "Listening on " << argv[3] << endl;
+      bool ok = server.Serve();
+      if (!ok) {
+        cerr << "Error: " << server.GetError() << endl;
+      }
+      cerr << "Served " << server.GetRequestCount() << " requests on "
+           << server.GetConnectionCount() << " connections" << endl;
+      if (dumpStats) {
+        Stats::Dump(cerr);
+      }
+      return ok ? 0 : 1;
     }
   else
     {
       cout << endl << "***Navigator***" << endl << endl;
       Navigator S = Navigator(argv[1]);
       S.Start();
+      if (dumpStats) {
+        Stats::Dump(cerr);
+      }
     }
   return 0;
 }
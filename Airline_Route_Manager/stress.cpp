@@ -0,0 +1,238 @@
+//Name: stress.cpp
+//Author:  Aswanth Jeyaram Kumar
+//Date:    10/17/2026
+//Desc: Stress test for concurrent reads. Reader threads read the routes
+//      published by a Navigator in concurrent mode. At the same time one
+//      writer adds routes, removes stops, reverses routes and optimizes
+//      them. Every read is checked for a consistent route: at least
+//      ROUTE_MIN valid stops, one leg per pair matching the catalog
+//      distance, and legs summing to the miles. Route counts must never
+//      go down. At the end every published route must match the writer's
+//      route. Prints the reads, edits and slowest read, and exits with 1
+//      on any failure.
+//
+//      Usage: ./proj3_stress [--data FILE] [--readers N] [--ms MS]
+
+#include "Navigator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+//Constants
+const int STRESS_READERS = 8; //Default reader threads
+const double STRESS_MS = 2000.0; //Default run time
+const int STRESS_MAX_ROUTES = 64; //Routes the writer builds before only editing
+const int STRESS_MAX_STOPS = 12; //Most stops in a new route
+const double STRESS_TOLERANCE = 1e-9; //Relative error allowed in the miles
+const unsigned STRESS_SEED = 20261017; //Seed for the writer's edits
+
+//What one reader saw
+struct ReaderResult {
+  long reads; //Routes read
+  long failures; //Reads that broke an invariant
+  double slowestUs; //Longest single read in microseconds
+};
+
+// Name: Close(double, double)
+// Desc: True if two mileages agree to STRESS_TOLERANCE
+bool Close(double a, double b) {
+  return fabs(a - b) <= STRESS_TOLERANCE * (fabs(a) + fabs(b) + 1.0);
+}
+
+// Name: CheckView(Navigator&, RouteView&)
+// Desc: Returns an error for an inconsistent route, or "" if it is fine
+string CheckView(const Navigator& navigator, const RouteView& view) {
+  int airports = navigator.GetCatalog().GetSize();
+  if (static_cast<int>(view.stops.size()) < ROUTE_MIN) {
+    return "route with " + to_string(view.stops.size()) + " stops";
+  }
+  if (view.legs.size() + 1 != view.stops.size()) {
+    return "legs do not match stops";
+  }
+  double total = 0.0;
+  for (int i = 0; i < static_cast<int>(view.stops.size()); i++) {
+    if (view.stops[i] < 0 || view.stops[i] >= airports) {
+      return "invalid airport id " + to_string(view.stops[i]);
+    }
+    if (i + 1 < static_cast<int>(view.stops.size())) {
+      double leg = navigator.AirportDistance(view.stops[i], view.stops[i + 1]);
+      if (!Close(leg, view.legs[i])) {
+        return "leg " + to_string(i) + " is " + to_string(view.legs[i]) +
+          " not " + to_string(leg);
+      }
+      total += view.legs[i];
+    }
+  }
+  if (!Close(total, view.miles)) {
+    return "legs sum to " + to_string(total) + " not " + to_string(view.miles);
+  }
+  if (view.name.empty()) {
+    return "route has no name";
+  }
+  return "";
+}
+
+// Name: Reader(Navigator&, atomic<bool>&, ReaderResult&, unsigned)
+// Desc: Reads random published routes until stop is set
+void Reader(const Navigator& navigator, const atomic<bool>& stop, ReaderResult& result,
+            unsigned seed) {
+  mt19937 random(seed);
+  RouteView view;
+  int lastCount = 0;
+  result.reads = 0;
+  result.failures = 0;
+  result.slowestUs = 0.0;
+  while (!stop.load(memory_order_relaxed)) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int count = navigator.ReadRouteCount();
+    if (count < lastCount) {
+      if (result.failures++ == 0) {
+        cerr << "Route count went from " << lastCount << " to " << count << endl;
+      }
+    }
+    lastCount = count;
+    if (count == 0) {
+      this_thread::yield();
+      continue;
+    }
+    int index = static_cast<int>(random() % count);
+    if (!navigator.ReadRoute(index, view)) {
+      if (result.failures++ == 0) {
+        cerr << "Route " << index << " of " << count << " not readable" << endl;
+      }
+      continue;
+    }
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    if (us > result.slowestUs) {
+      result.slowestUs = us;
+    }
+    string error = CheckView(navigator, view);
+    if (!error.empty() && result.failures++ == 0) {
+      cerr << "Route " << index << ": " << error << endl;
+    }
+    result.reads++;
+  }
+}
+
+// Name: Edit(Navigator&, mt19937&)
+// Desc: Makes one random route edit
+void Edit(Navigator& navigator, mt19937& random) {
+  int airports = navigator.GetAirportCount();
+  int routes = navigator.GetRouteCount();
+  int choice = routes < STRESS_MAX_ROUTES ? static_cast<int>(random() % 5) : 1 + static_cast<int>(random() % 4);
+  if (choice == 0 || routes == 0) {
+    vector<int> ids;
+    int stops = ROUTE_MIN + static_cast<int>(random() % (STRESS_MAX_STOPS - ROUTE_MIN + 1));
+    for (int i = 0; i < stops; i++) {
+      ids.push_back(static_cast<int>(random() % airports));
+    }
+    navigator.AddRoute(ids);
+    return;
+  }
+  int index = static_cast<int>(random() % routes);
+  Route* route = navigator.GetRoute(index);
+  if (choice == 1 || choice == 2) {
+    if (route->GetSize() > ROUTE_MIN) {
+      navigator.RemoveStop(index, static_cast<int>(random() % route->GetSize()));
+    } else {
+      navigator.ReverseStops(index);
+    }
+  } else if (choice == 3) {
+    navigator.ReverseStops(index);
+  } else {
+    OptimizeStats stats;
+    navigator.OptimizeRoute(index, random() % 2 == 0, 1.0, stats);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  string dataFile = "proj3_data.txt";
+  int readers = STRESS_READERS;
+  double ms = STRESS_MS;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+      dataFile = argv[++i];
+    } else if (strcmp(argv[i], "--readers") == 0 && i + 1 < argc) {
+      readers = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--ms") == 0 && i + 1 < argc) {
+      ms = atof(argv[++i]);
+    } else {
+      cout << "Usage: ./proj3_stress [--data FILE] [--readers N] [--ms MS]" << endl;
+      return 1;
+    }
+  }
+
+  ostream nowhere(nullptr); // Load messages are not wanted
+  Navigator navigator(dataFile);
+  navigator.SetLogStream(nowhere);
+  navigator.ReadFile();
+  if (navigator.GetAirportCount() < ROUTE_MIN) {
+    cerr << "Error loading " << dataFile << endl;
+    return 1;
+  }
+  navigator.EnableConcurrentReads();
+
+  atomic<bool> stop(false);
+  vector<ReaderResult> results(readers);
+  vector<thread> threads;
+  for (int i = 0; i < readers; i++) {
+    threads.push_back(thread(Reader, cref(navigator), cref(stop), ref(results[i]),
+                             STRESS_SEED + 1 + i));
+  }
+
+  mt19937 random(STRESS_SEED);
+  long edits = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  while (chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() < ms) {
+    Edit(navigator, random);
+    edits++;
+  }
+  stop = true;
+  for (int i = 0; i < readers; i++) {
+    threads[i].join();
+  }
+
+  // Published routes must match the writer's
+  long failures = 0;
+  long reads = 0;
+  double slowestUs = 0.0;
+  for (int i = 0; i < readers; i++) {
+    failures += results[i].failures;
+    reads += results[i].reads;
+    if (results[i].slowestUs > slowestUs) {
+      slowestUs = results[i].slowestUs;
+    }
+  }
+  if (navigator.ReadRouteCount() != navigator.GetRouteCount()) {
+    cerr << "Published " << navigator.ReadRouteCount() << " routes, not "
+         << navigator.GetRouteCount() << endl;
+    failures++;
+  }
+  RouteView view;
+  vector<int> stops;
+  for (int i = 0; i < navigator.GetRouteCount(); i++) {
+    Route* route = navigator.GetRoute(i);
+    stops.clear();
+    for (int j = 0; j < route->GetSize(); j++) {
+      stops.push_back(route->GetID(j));
+    }
+    if (!navigator.ReadRoute(i, view) || view.stops != stops || !CheckView(navigator, view).empty()) {
+      cerr << "Published route " << i << " does not match" << endl;
+      failures++;
+    }
+  }
+
+  cout << readers << " readers, " << edits << " edits, " << reads << " reads in "
+       << ms << " ms; slowest read " << slowestUs << " us" << endl;
+  cout << (failures == 0 ? "PASS" : "FAIL") << " (" << failures << " failures)" << endl;
+  return failures == 0 ? 0 : 1;
+}